@@ -3,10 +3,9 @@
  * --------------
  * Description: This header defines the Algae class, which extends the CircularLifeform
  * class. Algae are modeled as circular life forms with a constant radius defined by
- * `r_alg` (set to 1, as specified in constants.h). This class manages a static count
- * of Algae instances to track population levels within the simulation. It includes
- * constructors, a destructor, and methods to manage and query the count of algae
- * instances globally, emphasizing population dynamics.
+ * `r_alg` (set to 1, as specified in constants.h). An algae is a plain value: it is
+ * only born, compared, written to a file and eaten by the corals within the
+ * simulation.
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -22,24 +21,15 @@ class Algae : public CircularLifeform {
 public:
     // Constructor taking initial position and age
     Algae(const S2d& position, unsigned int initialAge);
-    Algae(const Algae& other);             // Copy constructor
-    Algae& operator=(const Algae& other);  // Assignment operator
     bool operator==(const Algae& other) const;
     bool operator!=(const Algae& other) const;
-    // Destructor
-    virtual ~Algae();
 
-    friend std::ostream& operator<<(std::ostream& os, const Algae& algae);
-
-    // Static method to access and modify the static count of Algae instances
-    static unsigned int getNbAlg();
-    static void incrementNbAlg();
-    static void decrementNbAlg();
-
-private:
-    static unsigned int nbAlg;  // Static count of Algae instances
+    // the radius is not saved for algae, it is always r_alg
+    void write(std::ostream& os, unsigned long now) const;
 };
 
-std::ostream& operator<<(std::ostream& os, const Algae& algae);
+// position, birth tick and radius, copied as plain memory
+static_assert(std::is_trivially_copyable_v<Algae>);
+static_assert(sizeof(Algae) == sizeof(S2d) + sizeof(long long) + sizeof(double));
 
 #endif  // ALGAE_H
@@ -0,0 +1,204 @@
+/**
+ * File: Assignment.cpp
+ * ---------------------
+ * Description: Implements the matching declared in Assignment.h.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "Assignment.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>  // for std::move
+
+namespace {
+constexpr int max_grid_side(1024);
+
+// the targets still free bucketed by cell, about one per cell over the box around
+// them: cell c holds members[start[c]] to members[end[c]], a taken target is swapped
+// out of that range so the scans only see free ones
+class TargetGrid {
+public:
+    TargetGrid(const std::vector<S2d>& targets_, const std::vector<unsigned>& free)
+        : targets(&targets_),
+          grid_side(std::clamp(static_cast<int>(std::sqrt(free.size())), 1,
+                               max_grid_side)),
+          origin(targets_[free.front()]),
+          start(grid_side * grid_side + 1, 0),
+          members(free.size()),
+          slot_of(targets_.size()),
+          built_size(free.size()),
+          free_count(free.size()) {
+        S2d corner(origin);
+        for (unsigned target : free) {
+            const S2d& point = (*targets)[target];
+            origin = {std::min(origin.x, point.x), std::min(origin.y, point.y)};
+            corner = {std::max(corner.x, point.x), std::max(corner.y, point.y)};
+        }
+        double extent = std::max(corner.x - origin.x, corner.y - origin.y);
+        cell_size = extent > 0 ? extent / grid_side : 1.0;
+
+        for (unsigned target : free) {
+            ++start[cell_of((*targets)[target]) + 1];
+        }
+        for (size_t c = 1; c < start.size(); ++c) {
+            start[c] += start[c - 1];
+        }
+        end.assign(start.begin(), start.end() - 1);
+        for (unsigned target : free) {
+            slot_of[target] = end[cell_of((*targets)[target])]++;
+            members[slot_of[target]] = target;
+        }
+    }
+
+    void take(unsigned target) {
+        unsigned& last = end[cell_of((*targets)[target])];
+        --last;
+        unsigned moved = members[last];
+        std::swap(members[slot_of[target]], members[last]);
+        std::swap(slot_of[target], slot_of[moved]);
+        --free_count;
+    }
+
+    // once most targets are taken the rings cross many empty cells, time to rebuild
+    bool is_sparse() const { return 4 * free_count < built_size; }
+
+    // nearest free target, -1 if none; ties go to the lowest index
+    int nearest(const S2d& position, double& distance) const {
+        int column = clamp_cell(position.x - origin.x);
+        int row = clamp_cell(position.y - origin.y);
+        int best = -1;
+        distance = 0;
+        for (int ring = 0; ring < grid_side; ++ring) {
+            for (int y = row - ring; y <= row + ring; ++y) {
+                for (int x = column - ring; x <= column + ring; ++x) {
+                    bool on_ring = y == row - ring || y == row + ring ||
+                                   x == column - ring || x == column + ring;
+                    if (on_ring && x >= 0 && y >= 0 && x < grid_side &&
+                        y < grid_side) {
+                        scan_cell(y * grid_side + x, position, best, distance);
+                    }
+                }
+            }
+            // anything in the next ring is at least ring cells away
+            if (best != -1 && distance <= ring * cell_size) {
+                break;
+            }
+        }
+        return best;
+    }
+
+private:
+    const std::vector<S2d>* targets;  // a pointer so the grid can be rebuilt
+    int grid_side;  // cells per side
+    S2d origin;     // lowest corner of the grid
+    double cell_size;
+    std::vector<unsigned> start;
+    std::vector<unsigned> end;
+    std::vector<unsigned> members;
+    std::vector<unsigned> slot_of;  // where each free target is in members
+    size_t built_size;
+    size_t free_count;
+
+    int clamp_cell(double offset) const {
+        return std::clamp(static_cast<int>(offset / cell_size), 0, grid_side - 1);
+    }
+    int cell_of(const S2d& point) const {
+        return clamp_cell(point.y - origin.y) * grid_side +
+               clamp_cell(point.x - origin.x);
+    }
+    void scan_cell(int cell, const S2d& position, int& best, double& distance) const {
+        for (unsigned i = start[cell]; i < end[cell]; ++i) {
+            int target = members[i];
+            double d = calculateDistance((*targets)[target], position);
+            if (best == -1 || d < distance || (d == distance && target < best)) {
+                best = target;
+                distance = d;
+            }
+        }
+    }
+};
+
+struct Candidate {
+    double distance;
+    int seeker;
+    int target;
+};
+
+// smallest distance on top of the heap, then the lowest seeker index
+struct FartherFirst {
+    bool operator()(const Candidate& a, const Candidate& b) const {
+        if (a.distance != b.distance) {
+            return a.distance > b.distance;
+        }
+        return a.seeker > b.seeker;
+    }
+};
+}  // namespace
+
+std::vector<int> assignment::match_nearest(const std::vector<S2d>& seekers,
+                                           const std::vector<S2d>& targets) {
+    std::vector<int> matches(seekers.size(), -1);
+    if (seekers.empty() || targets.empty()) {
+        return matches;
+    }
+    std::vector<unsigned> free(targets.size());
+    for (unsigned t = 0; t < targets.size(); ++t) {
+        free[t] = t;
+    }
+    std::vector<bool> taken(targets.size(), false);
+    TargetGrid grid(targets, free);
+
+    std::vector<Candidate> heap_storage;
+    heap_storage.reserve(seekers.size());
+    std::priority_queue<Candidate, std::vector<Candidate>, FartherFirst> heap(
+        FartherFirst(), std::move(heap_storage));
+    for (int s = 0; s < static_cast<int>(seekers.size()); ++s) {
+        double distance;
+        int target = grid.nearest(seekers[s], distance);
+        heap.push({distance, s, target});
+    }
+
+    size_t left = targets.size();
+    while (!heap.empty() && left > 0) {
+        Candidate candidate = heap.top();
+        heap.pop();
+        if (taken[candidate.target]) {
+            // taken by a closer pair since, look again for this seeker
+            candidate.target =
+                grid.nearest(seekers[candidate.seeker], candidate.distance);
+            heap.push(candidate);
+            continue;
+        }
+        matches[candidate.seeker] = candidate.target;
+        taken[candidate.target] = true;
+        grid.take(candidate.target);
+        --left;
+        if (left > 0 && grid.is_sparse()) {
+            free.clear();
+            for (unsigned t = 0; t < targets.size(); ++t) {
+                if (!taken[t]) {
+                    free.push_back(t);
+                }
+            }
+            grid = TargetGrid(targets, free);
+        }
+    }
+    return matches;
+}
+
+double assignment::total_distance(const std::vector<S2d>& seekers,
+                                  const std::vector<S2d>& targets,
+                                  const std::vector<int>& matches) {
+    double total(0);
+    for (size_t s = 0; s < seekers.size(); ++s) {
+        if (matches[s] >= 0) {
+            total += calculateDistance(seekers[s], targets[matches[s]]);
+        }
+    }
+    return total;
+}
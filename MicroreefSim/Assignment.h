@@ -0,0 +1,44 @@
+/**
+ * File: Assignment.h
+ * -------------------
+ * Description: Matches the free scavengers with the dead corals nobody eats, for the
+ *              global assignment mode of the Simulation (Simulation::Assignment).
+ *
+ *              The default mode lets each free scavenger take the nearest coral
+ *              left, in the order of the vector, so an early scavenger can take
+ *              the coral that was much closer to a later one. Here the pairs are
+ *              taken by increasing distance over all the scavengers at once: the
+ *              closest pair first, then the closest among the remaining ones, and
+ *              so on. It is the greedy matching by global distance, not the optimal
+ *              one, but it never gives a coral to a scavenger when another free
+ *              scavenger is closer to it and still unmatched.
+ *
+ *              The corals are bucketed in a uniform grid, about one per cell, so
+ *              each scavenger only looks at the cells around it; the grid is
+ *              rebuilt smaller as the corals get taken. A heap holds the nearest
+ *              coral of each scavenger. When the coral on top was taken meanwhile,
+ *              the next nearest one is looked up and pushed back.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef ASSIGNMENT_H
+#define ASSIGNMENT_H
+
+#include <vector>
+
+#include "shape.h"
+
+namespace assignment {
+// for each seeker the index of the target it gets, -1 when the targets ran out
+std::vector<int> match_nearest(const std::vector<S2d>& seekers,
+                               const std::vector<S2d>& targets);
+
+// sum of the distances between the matched pairs
+double total_distance(const std::vector<S2d>& seekers, const std::vector<S2d>& targets,
+                      const std::vector<int>& matches);
+}  // namespace assignment
+
+#endif  // ASSIGNMENT_H
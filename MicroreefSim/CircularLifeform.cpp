@@ -4,8 +4,8 @@
  * File: CircularLifeform.cpp
  * --------------------------
  * Description: This source file implements the CircularLifeform class, derived from
- * the Lifeform class. It provides constructors, a destructor, and methods to manage
- * the unique attribute of radius, along with inherited features like position and age.
+ * the Lifeform class. It provides the constructor and methods to manage the unique
+ * attribute of radius, along with inherited features like position and age.
  * The implementation ensures that circular life forms can be effectively managed
  * within the ecosystem simulation, including operations like printing to output
  * streams, comparing life forms, and adjusting life form properties.
@@ -24,22 +24,6 @@ CircularLifeform::CircularLifeform(const S2d& position, double radius,
     } */
 }
 
-// Copy constructor implementation
-CircularLifeform::CircularLifeform(const CircularLifeform& other)
-    : Lifeform(other), radius(other.radius) {}
-
-// Destructor implementation
-CircularLifeform::~CircularLifeform() {}
-
-// Assignment operator implementation
-
-CircularLifeform& CircularLifeform::operator=(const CircularLifeform& other) {
-    if (this != &other) {
-        Lifeform::operator=(other);
-        radius = other.radius;
-    }
-    return *this;
-}
 bool CircularLifeform::operator==(const CircularLifeform& other) const {
     return Lifeform::operator==(other) && (radius == other.radius);
 }
@@ -56,9 +40,7 @@ void CircularLifeform::setRadius(double newRadius) {
     radius = newRadius;
 }
 
-std::ostream& operator<<(std::ostream& os, const CircularLifeform& other) {
-    os << static_cast<const Lifeform&>(other) << " " << other.radius;
-    // transofirmw other en lifeform en perd de l'info mais c ce quon veut ici parceque
-    // on sait affichier un liformw normale big brain
-    return os;
+void CircularLifeform::write(std::ostream& os, unsigned long now) const {
+    Lifeform::write(os, now);
+    os << " " << radius;
 }
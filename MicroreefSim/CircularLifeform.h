@@ -23,20 +23,14 @@
 class CircularLifeform : public Lifeform {
 public:
     CircularLifeform(const S2d& position, double radius, unsigned int initialAge = 1);
-    CircularLifeform(const CircularLifeform& other);             // Copy constructor
-    CircularLifeform& operator=(const CircularLifeform& other);  // Assignment operator
     bool operator==(const CircularLifeform& other) const;
     bool operator!=(const CircularLifeform& other) const;
-    virtual ~CircularLifeform();  // destructor
     double getRadius() const;
     void setRadius(double newRadius);
-    friend std::ostream& operator<<(std::ostream& os,
-                                    const CircularLifeform& lifeform);
+    void write(std::ostream& os, unsigned long now) const;  // "x y age radius"
 
 protected:
     double radius;
 };
 
-std::ostream& operator<<(std::ostream& os, const CircularLifeform& lifeform);
-
 #endif  // CIRCULARLIFEFORM_H
@@ -2,11 +2,9 @@
  * File: Coral.cpp
  * ----------------
  * Description: Implements the Coral class from Coral.h. This source file includes the
- * logic for constructing coral entities, managing their life cycle, and maintaining a
- * unique ID system. The methods provided allow for dynamic interaction with coral
- * attributes such as segment addition, status updates, and rotational behavior
- * adjustments. Additional functionalities include maintaining a global set of IDs to
- * ensure uniqueness among all coral instances within the simulation.
+ * logic for constructing coral entities and managing their life cycle. The methods
+ * provided allow for dynamic interaction with coral attributes such as segment
+ * addition, status updates, and rotational behavior adjustments.
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -15,9 +13,6 @@
 
 #include "Coral.h"
 
-unsigned int Coral::nbCoral = 0;
-std::set<int> Coral::uniqueIDs;
-
 Coral::Coral(const S2d& base_, unsigned int initialAge, int ID, Statut_cor statut,
              Dir_rot_cor direction_rotation, Statut_dev statut_dev, unsigned int nbseg,
              double firstAngle, double firstLength)
@@ -27,7 +22,6 @@ Coral::Coral(const S2d& base_, unsigned int initialAge, int ID, Statut_cor statu
       direction_rotation(direction_rotation),
       statut_dev(statut_dev),
       nbseg(nbseg) {
-    ++nbCoral;
     /* //----debugging--
     if (segments.empty()) {
         std::cerr << "Error: Coral constructor created coral with empty segments.\n";
@@ -38,35 +32,6 @@ Coral::Coral(const S2d& base_, unsigned int initialAge, int ID, Statut_cor statu
     }
     //----debugging-- */
 }
-Coral::Coral(const Coral& other)
-    : SegmentLifeform(other),
-      ID(other.ID),
-      statut(other.statut),
-      direction_rotation(other.direction_rotation),
-      statut_dev(other.statut_dev),
-      nbseg(other.nbseg) {
-    ++nbCoral;
-}
-
-Coral& Coral::operator=(const Coral& other) {
-    if (this != &other) {
-        SegmentLifeform::operator=(other);
-        ID = other.ID;
-        statut = other.statut;
-        direction_rotation = other.direction_rotation;
-        statut_dev = other.statut_dev;
-        nbseg = other.nbseg;
-    }
-    return *this;
-}
-
-Coral::~Coral() {
-    --nbCoral;
-    // if coral id is in the uniqueIDs set, remove it
-    /* if (uniqueIDs.find(ID) != uniqueIDs.end()) {
-        uniqueIDs.erase(ID);
-    } */
-}
 
 bool Coral::operator==(const Coral& other) const {
     return SegmentLifeform::operator==(other) && ID == other.ID &&
@@ -78,13 +43,11 @@ bool Coral::operator!=(const Coral& other) const {
     return !(*this == other);
 }
 
-std::ostream& operator<<(std::ostream& os, const Coral& coral) {
-    os << static_cast<const Lifeform&>(coral) << " " << coral.ID << " " << coral.statut
-       << " " << coral.direction_rotation << " " << coral.statut_dev << " "
-       << coral.nbseg << "\n"
-       << static_cast<const SegmentLifeform&>(coral);
-
-    return os;
+void Coral::write(std::ostream& os, unsigned long now) const {
+    Lifeform::write(os, now);
+    os << " " << ID << " " << statut << " " << direction_rotation << " " << statut_dev
+       << " " << nbseg << "\n"
+       << static_cast<const SegmentLifeform&>(*this);
 }
 /* void Coral::addSegment(double angle, double length) {
     if (!segments.empty()) {
@@ -123,18 +86,6 @@ void Coral::printSegments() const {
     }
 }  // I overide the << operator in the coral class so we can delete this method
 
-bool Coral::addUniqueID(int ID) {
-    // Attempt to insert the ID into the uniqueIDs container
-    auto [_, isUnique] = uniqueIDs.insert(ID);
-
-    // Return whether the insertion was successful and the ID is unique
-    return isUnique;
-}
-
-void Coral::removeUniqueID(int ID) {
-    uniqueIDs.erase(ID);
-}
-
 int Coral::getID() const {
     return ID;
 }
@@ -176,21 +127,6 @@ unsigned int Coral::getNbSeg() const {
     return nbseg;
 }
 
-std::set<int> Coral::getUniqueIDs_copy() {
-    return uniqueIDs;
-}
-
-std::set<int>& Coral::getUniqueIDs() {
-    return uniqueIDs;
-}
-void Coral::setUniqueIDs(std::set<int> newUniqueIDs) {
-    uniqueIDs = newUniqueIDs;
-}
-
-void Coral::clear_uniqueIDs() {
-    uniqueIDs.clear();
-}
-
 void Coral::killCoral() {
     statut = DEAD;
 }
@@ -245,11 +181,11 @@ void Coral::extend_last_segment(double delta_l) {
     // "\n";
 }
 
-void Coral::setSegments(const std::vector<Segment>& newSegments) {
+void Coral::setSegments(const SegmentVector& newSegments) {
     segments = newSegments;
 }
 
-std::vector<Segment> Coral::getSegments() const {
+const SegmentVector& Coral::getSegments() const {
     return segments;
 }
 
@@ -288,14 +224,6 @@ bool Coral::last_segment_is_within_boundaries(double max) const {
     return true;
 }
 
-void Coral::printIDs() {
-    std::cout << "Unique IDs: ";
-    for (const auto& ID : uniqueIDs) {
-        std::cout << ID << " ";
-    }
-    std::cout << std::endl;
-}
-
 void Coral::Alternate_StatutDev() {
     if (statut_dev == EXTEND) {
         statut_dev = REPRO;
@@ -317,14 +245,6 @@ void Coral::incrementNbSeg() {
     ++nbseg;
 }
 
-void Coral::incrementNbCoral() {
-    ++nbCoral;
-}
-
-void Coral::decrementNbCoral() {
-    --nbCoral;
-}
-
 void Coral::remove_last_segment() {
     if (!segments.empty()) {
         segments.pop_back();
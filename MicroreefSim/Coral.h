@@ -6,8 +6,8 @@
  * life forms with unique attributes such as an ID, status, direction of rotation, and
  * developmental status. This class provides methods for segment management and
  * behavior specific to corals, such as adding segments, changing status, and handling
- * unique identification. Coral instances track their population with a static ID set
- * to ensure each instance is unique.
+ * unique identification. The IDs in use are kept by the Simulation that owns the
+ * corals, so that each of them is unique.
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -17,8 +17,6 @@
 #ifndef CORAL_H
 #define CORAL_H
 
-#include <set>
-
 #include "SegmentLifeform.h"
 
 class Coral : public SegmentLifeform {
@@ -27,13 +25,10 @@ public:
           Dir_rot_cor direction_rotation, Statut_dev statut_dev, unsigned int nbseg,
           double firstAngle, double firstLength);
 
-    Coral(const Coral& other);
-    Coral& operator=(const Coral& other);
     bool operator==(const Coral& other) const;
     bool operator!=(const Coral& other) const;
-    friend std::ostream& operator<<(std::ostream& os, const Coral& coral);
-
-    virtual ~Coral();
+    // the line of the coral in the file format then one line per segment
+    void write(std::ostream& os, unsigned long now) const;
 
     void addSegment(double angle, double length);
     int getID() const;
@@ -47,14 +42,6 @@ public:
     unsigned int getNbSeg() const;
 
     static bool checkForCollision(const S2d& base, double angle, double length);
-    static bool addUniqueID(int ID);
-    static void removeUniqueID(int ID);
-    // uniqueIDs setter and getter
-    static std::set<int> getUniqueIDs_copy();
-    static void setUniqueIDs(std::set<int> newUniqueIDs);
-
-    static void clear_uniqueIDs();
-    static std::set<int>& getUniqueIDs();
 
     // debuging method to cout the segments vector
     void printSegments() const;
@@ -65,18 +52,15 @@ public:
 
     void extend_last_segment(double delta_l);  // extend the last segment by delta_l
 
-    void setSegments(const std::vector<Segment>& newSegments);
-    std::vector<Segment> getSegments() const;
+    void setSegments(const SegmentVector& newSegments);
+    const SegmentVector& getSegments() const;
     void Alternate_StatutDev();
     void incrementNbSeg();
 
     bool isWithinBoundaries(double max) const;
 
-    static void printIDs();
     void updateLastSegmentLength(double newLength);
 
-    static void incrementNbCoral();
-    static void decrementNbCoral();
     bool last_segment_is_within_boundaries(double max) const;
 
     void remove_last_segment();
@@ -90,10 +74,6 @@ private:
     Dir_rot_cor direction_rotation;
     Statut_dev statut_dev;
     unsigned int nbseg;
-    static unsigned int nbCoral;
-    static std::set<int> uniqueIDs;  // for checking unique IDs
 };
 
-std::ostream& operator<<(std::ostream& os, const Coral& coral);
-
 #endif  // CORAL_H
@@ -0,0 +1,95 @@
+/**
+ * File: CounterRandom.cpp
+ * ------------------------
+ * Description: Implements Philox4x32-10 and the draws of CounterRandom.h.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "CounterRandom.h"
+
+namespace {
+// multipliers and key increments (Weyl sequence) of Philox4x32
+constexpr std::uint32_t multiplier_0(0xD2511F53u);
+constexpr std::uint32_t multiplier_1(0xCD9E8D57u);
+constexpr std::uint32_t key_step_0(0x9E3779B9u);
+constexpr std::uint32_t key_step_1(0xBB67AE85u);
+constexpr unsigned rounds(10);
+
+// the third word of the counter: the event in the high half, the block in the low
+// one, so an event has 65536 blocks of draws per tick and id
+constexpr unsigned block_bits(16);
+}  // namespace
+
+CounterRandom::Block CounterRandom::philox(Block counter, std::uint64_t key) {
+    std::uint32_t key_0 = static_cast<std::uint32_t>(key);
+    std::uint32_t key_1 = static_cast<std::uint32_t>(key >> 32);
+    for (unsigned round = 0; round < rounds; ++round) {
+        std::uint64_t product_0 = std::uint64_t(multiplier_0) * counter[0];
+        std::uint64_t product_1 = std::uint64_t(multiplier_1) * counter[2];
+        counter = {static_cast<std::uint32_t>(product_1 >> 32) ^ counter[1] ^ key_0,
+                   static_cast<std::uint32_t>(product_1),
+                   static_cast<std::uint32_t>(product_0 >> 32) ^ counter[3] ^ key_1,
+                   static_cast<std::uint32_t>(product_0)};
+        key_0 += key_step_0;
+        key_1 += key_step_1;
+    }
+    return counter;
+}
+
+CounterRandom::CounterRandom(std::uint64_t seed_) : key(seed_) {}
+
+void CounterRandom::seed(std::uint64_t seed_) {
+    key = seed_;
+}
+
+std::uint64_t CounterRandom::getSeed() const {
+    return key;
+}
+
+CounterRandom::Draws CounterRandom::draws(unsigned long tick, Event event,
+                                          std::uint32_t id) const {
+    std::uint64_t tick_64 = tick;
+    return Draws(key, {static_cast<std::uint32_t>(tick_64),
+                       static_cast<std::uint32_t>(tick_64 >> 32),
+                       static_cast<std::uint32_t>(event) << block_bits, id});
+}
+
+CounterRandom::Draws::Draws(std::uint64_t key_, const Block& counter_)
+    : key(key_), counter(counter_), words{}, used(4) {}
+
+std::uint32_t CounterRandom::Draws::next() {
+    if (used == words.size()) {
+        words = philox(counter, key);
+        ++counter[2];  // the next block
+        used = 0;
+    }
+    return words[used++];
+}
+
+double CounterRandom::Draws::uniform() {
+    std::uint64_t high = next() >> 5;  // 27 bits
+    std::uint64_t low = next() >> 6;   // 26 bits
+    return static_cast<double>(high << 26 | low) * (1.0 / (std::uint64_t(1) << 53));
+}
+
+std::uint32_t CounterRandom::Draws::below(std::uint32_t bound) {
+    // Lemire's multiply and shift, rejecting the few products that would make the
+    // low values more likely
+    std::uint64_t product = std::uint64_t(next()) * bound;
+    std::uint32_t low = static_cast<std::uint32_t>(product);
+    if (low < bound) {
+        std::uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            product = std::uint64_t(next()) * bound;
+            low = static_cast<std::uint32_t>(product);
+        }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+}
+
+bool CounterRandom::Draws::bernoulli(double probability) {
+    return uniform() < probability;
+}
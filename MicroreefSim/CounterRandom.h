@@ -0,0 +1,69 @@
+/**
+ * File: CounterRandom.h
+ * ----------------------
+ * Description: Defines the CounterRandom class, a counter-based random generator
+ *              for the COUNTER random mode of the Simulation (Simulation::RandomMode).
+ *
+ *              The engine of the default mode is one sequence: every draw depends
+ *              on all the draws made before it, so the updates have to draw in
+ *              exactly the same order to give the same run. Here a draw is a pure
+ *              function of its key, the seed, and of its counter: the tick, the
+ *              kind of event and the id of the entity or event it is for. Any
+ *              thread can compute the draws of any entity in any order and get
+ *              the same numbers, and adding a draw somewhere changes no other.
+ *
+ *              The function is Philox4x32-10 (Salmon et al., "Parallel random
+ *              numbers: as easy as 1, 2, 3", SC 2011): ten rounds of two 32-bit
+ *              multiplications turn a 128-bit counter and a 64-bit key into four
+ *              32-bit words, which pass the BigCrush statistical tests.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef COUNTER_RANDOM_H
+#define COUNTER_RANDOM_H
+
+#include <array>
+#include <cstdint>
+
+class CounterRandom {
+public:
+    using Block = std::array<std::uint32_t, 4>;
+
+    // what a draw is for, part of its counter so that two events never share draws
+    enum Event : std::uint32_t { ALGAE_BIRTH };
+
+    // the draws of one event, in order; the four words of a block are used before
+    // the next block is computed
+    class Draws {
+    public:
+        Draws(std::uint64_t key_, const Block& counter_);
+        std::uint32_t next();
+        double uniform();                 // in [0, 1), 53 random bits
+        std::uint32_t below(std::uint32_t bound);  // in [0, bound), unbiased
+        bool bernoulli(double probability);
+
+    private:
+        std::uint64_t key;
+        Block counter;
+        Block words;
+        unsigned used;  // words of the current block already drawn
+    };
+
+    explicit CounterRandom(std::uint64_t seed_ = 1);
+    void seed(std::uint64_t seed_);
+    std::uint64_t getSeed() const;
+
+    // the draws of event at tick for the entity or event id; an event that
+    // happens once per update, such as the birth of an algae, uses id 0
+    Draws draws(unsigned long tick, Event event, std::uint32_t id) const;
+
+    static Block philox(Block counter, std::uint64_t key);
+
+private:
+    std::uint64_t key;
+};
+
+#endif  // COUNTER_RANDOM_H
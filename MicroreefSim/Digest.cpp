@@ -0,0 +1,310 @@
+/**
+ * File: Digest.cpp
+ * -----------------
+ * Description: Implements the digests and the digest streams of Digest.h.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "Digest.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Trace.h"
+
+namespace {
+constexpr char header[] = "# microreef digest 1";
+constexpr const char* part_names[] = {"total", "algae", "corals", "scavengers",
+                                      "random"};
+constexpr size_t part_count(sizeof(part_names) / sizeof(part_names[0]));
+
+// the finalizer of splitmix64, every bit of the word changes half the bits out
+std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+void add_position(digest::Hasher& hasher, const S2d& position) {
+    hasher.add(position.x);
+    hasher.add(position.y);
+}
+
+std::ostream& hex(std::ostream& out, digest::Value value) {
+    return out << std::hex << std::setw(16) << std::setfill('0') << value
+               << std::dec << std::setfill(' ');
+}
+
+// the line of one update and the lines of its entities, if any
+struct Block {
+    std::string line;
+    unsigned long tick;
+    std::vector<std::string> parts;  // as part_names
+    std::vector<std::string> entities;
+};
+
+class StreamReader {
+public:
+    explicit StreamReader(std::istream& in_) : in(in_), has_line(false) {}
+
+    bool next(Block& block) {  // false at the end of the stream
+        block.entities.clear();
+        while (read_line()) {
+            has_line = false;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::istringstream fields(line);
+            block.line = line;
+            fields >> block.tick;
+            block.parts.assign(part_count, "");
+            for (auto& part : block.parts) {
+                fields >> part;
+            }
+            // the entity lines start with a letter, the next update with a digit
+            while (read_line() && !line.empty() &&
+                   std::isalpha(static_cast<unsigned char>(line[0]))) {
+                block.entities.push_back(line);
+                has_line = false;
+            }
+            return true;
+        }
+        return false;
+    }
+
+private:
+    std::istream& in;
+    std::string line;
+    bool has_line;  // line was read and not used yet
+
+    bool read_line() {
+        if (!has_line) {
+            has_line = static_cast<bool>(std::getline(in, line));
+        }
+        return has_line;
+    }
+};
+
+// "coral 3 (ID 12)" from "c 3 12 <digest>"
+std::string describe_entity(const std::string& entity_line) {
+    std::istringstream fields(entity_line);
+    std::string kind, index, ID;
+    fields >> kind >> index;
+    if (kind == "a") {
+        return "algae " + index;
+    }
+    if (kind == "c") {
+        fields >> ID;
+        return "coral " + index + " (ID " + ID + ")";
+    }
+    return "scavenger " + index;
+}
+
+void report_entities(const Block& first, const Block& second, std::ostream& report) {
+    if (first.entities.empty() || second.entities.empty()) {
+        report << "  no entity lines, write the streams with --entities to know "
+                  "which entity differs first\n";
+        return;
+    }
+    size_t common = std::min(first.entities.size(), second.entities.size());
+    for (size_t i = 0; i < common; ++i) {
+        if (first.entities[i] != second.entities[i]) {
+            std::string a = describe_entity(first.entities[i]);
+            std::string b = describe_entity(second.entities[i]);
+            report << "  first entity that differs: " << a;
+            if (b != a) {
+                report << " against " << b;
+            }
+            report << '\n';
+            return;
+        }
+    }
+    const Block& longer = first.entities.size() > common ? first : second;
+    report << "  only in the " << (&longer == &first ? "first" : "second")
+           << " stream: " << describe_entity(longer.entities[common]) << '\n';
+}
+}  // namespace
+
+digest::Hasher::Hasher() : state(0x6d6963726f726566ull) {}
+
+void digest::Hasher::add(std::uint64_t word) {
+    state = mix(state ^ (word + 0x9e3779b97f4a7c15ull));
+}
+
+void digest::Hasher::add(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    add(bits);
+}
+
+void digest::Hasher::add(long long value) {
+    add(static_cast<std::uint64_t>(value));
+}
+
+digest::Value digest::Hasher::value() const {
+    return state;
+}
+
+digest::Value digest::of(const Algae& algae) {
+    Hasher hasher;
+    add_position(hasher, algae.getPosition());
+    hasher.add(algae.getBirthTick());
+    return hasher.value();
+}
+
+digest::Value digest::of(const Coral& coral) {
+    Hasher hasher;
+    add_position(hasher, coral.getPosition());
+    hasher.add(coral.getBirthTick());
+    hasher.add(static_cast<long long>(coral.getID()));
+    hasher.add(static_cast<std::uint64_t>(coral.getStatut()) |
+               static_cast<std::uint64_t>(coral.getDirectionRotation()) << 8 |
+               static_cast<std::uint64_t>(coral.getStatutDev()) << 16 |
+               static_cast<std::uint64_t>(coral.getNbSeg()) << 32);
+    hasher.add(static_cast<std::uint64_t>(coral.getSegments().size()));
+    for (const auto& segment : coral.getSegments()) {
+        add_position(hasher, segment.getBase());
+        hasher.add(segment.getAngle());
+        hasher.add(segment.getLength());
+    }
+    return hasher.value();
+}
+
+digest::Value digest::of(const Scavenger& scavenger) {
+    Hasher hasher;
+    add_position(hasher, scavenger.getPosition());
+    hasher.add(scavenger.getRadius());
+    hasher.add(scavenger.getBirthTick());
+    hasher.add(static_cast<std::uint64_t>(scavenger.getStatus()));
+    hasher.add(static_cast<long long>(scavenger.getTargetCoralId()));
+    return hasher.value();
+}
+
+digest::TickDigest digest::compute(const Simulation& simulation) {
+    TRACE_SCOPE("digest::compute");
+    TickDigest digest{simulation.getTick(), 0, 0, 0, 0, 0};
+    Hasher algae;
+    for (const auto& entity : simulation.get_algae_in_simulation()) {
+        algae.add(of(entity));
+    }
+    Hasher corals;
+    for (const auto& entity : simulation.get_coral_in_simulation()) {
+        corals.add(of(entity));
+    }
+    Hasher scavengers;
+    for (const auto& entity : simulation.get_scavenger_in_simulation()) {
+        scavengers.add(of(entity));
+    }
+    Simulation::Snapshot resume{{}, {}, {}, 0, {}, 0, Simulation::ENGINE, 1};
+    simulation.takeResumeState(resume);
+    Hasher random;
+    for (char c : resume.random_engine) {
+        random.add(static_cast<std::uint64_t>(static_cast<unsigned char>(c)));
+    }
+    random.add(static_cast<long long>(resume.next_coral_ID));
+    if (resume.random_mode == Simulation::COUNTER) {
+        // the draws come from the seed, the engine never moves; only added in this
+        // mode so the digests of the engine mode, and the golden files, stay valid
+        random.add(static_cast<std::uint64_t>(resume.random_mode));
+        random.add(static_cast<std::uint64_t>(resume.random_seed));
+    }
+
+    digest.algae = algae.value();
+    digest.corals = corals.value();
+    digest.scavengers = scavengers.value();
+    digest.random = random.value();
+    Hasher total;
+    total.add(static_cast<std::uint64_t>(digest.tick));
+    for (Value part : {digest.algae, digest.corals, digest.scavengers, digest.random}) {
+        total.add(part);
+    }
+    digest.total = total.value();
+    return digest;
+}
+
+void digest::writeHeader(std::ostream& out) {
+    out << header << "\n# tick";
+    for (const char* name : part_names) {
+        out << ' ' << name;
+    }
+    out << '\n';
+}
+
+void digest::write(std::ostream& out, const TickDigest& digest) {
+    out << std::dec << digest.tick;
+    for (Value part : {digest.total, digest.algae, digest.corals, digest.scavengers,
+                       digest.random}) {
+        hex(out << ' ', part);
+    }
+    out << '\n';
+}
+
+void digest::writeEntities(std::ostream& out, const Simulation& simulation) {
+    const auto& algae = simulation.get_algae_in_simulation();
+    for (size_t i = 0; i < algae.size(); ++i) {
+        hex(out << "a " << i << ' ', of(algae[i])) << '\n';
+    }
+    const auto& corals = simulation.get_coral_in_simulation();
+    for (size_t i = 0; i < corals.size(); ++i) {
+        hex(out << "c " << i << ' ' << corals[i].getID() << ' ', of(corals[i]))
+            << '\n';
+    }
+    const auto& scavengers = simulation.get_scavenger_in_simulation();
+    for (size_t i = 0; i < scavengers.size(); ++i) {
+        hex(out << "s " << i << ' ', of(scavengers[i])) << '\n';
+    }
+}
+
+bool digest::compare(std::istream& first, std::istream& second, std::ostream& report) {
+    StreamReader first_reader(first);
+    StreamReader second_reader(second);
+    Block a;
+    Block b;
+    unsigned long compared(0);
+    while (true) {
+        bool more_first = first_reader.next(a);
+        bool more_second = second_reader.next(b);
+        if (!more_first || !more_second) {
+            if (more_first || more_second) {
+                report << "the " << (more_first ? "second" : "first")
+                       << " stream ends after " << compared << " updates, the other "
+                       << "goes on at tick " << (more_first ? a.tick : b.tick) << '\n';
+                return false;
+            }
+            report << "identical over " << compared << " updates\n";
+            return true;
+        }
+        bool both_have_entities = !a.entities.empty() && !b.entities.empty();
+        if (a.line != b.line || (both_have_entities && a.entities != b.entities)) {
+            break;
+        }
+        ++compared;
+    }
+
+    if (a.tick != b.tick) {
+        report << "the ticks differ after " << compared << " updates: " << a.tick
+               << " against " << b.tick << '\n';
+        return false;
+    }
+    report << "first divergence at tick " << a.tick << ", after " << compared
+           << " identical updates\n  differs:";
+    for (size_t i = 1; i < part_count; ++i) {
+        if (a.parts[i] != b.parts[i]) {
+            report << ' ' << part_names[i];
+        }
+    }
+    report << '\n';
+    report_entities(a, b, report);
+    return false;
+}
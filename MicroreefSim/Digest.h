@@ -0,0 +1,76 @@
+/**
+ * File: Digest.h
+ * ---------------
+ * Description: A 64-bit digest of the whole state of a Simulation, cheap enough to
+ *              take after every update, to check that another implementation
+ *              (optimized, parallel, reordered) gives exactly the same run as the
+ *              reference one.
+ *
+ *              Every field of every entity is hashed bit for bit, doubles
+ *              included, in the order of the vectors since it is the order of the
+ *              updates. The random engine and the next coral ID are hashed too:
+ *              they decide the updates to come, and so do the random mode and the
+ *              seed in the counter mode (CounterRandom.h), where the engine is not
+ *              used. The state is fed to the hash one 64-bit word at a time, so a
+ *              digest costs one pass over the entities and no allocation besides
+ *              the engine state.
+ *
+ *              A digest stream is a text file with one line per update: the tick,
+ *              the digest of the whole state, then the digests of the algae, the
+ *              corals, the scavengers and the random state. With the entities
+ *              option, one line per entity follows, so that compare can tell which
+ *              entity diverged first.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef DIGEST_H
+#define DIGEST_H
+
+#include <cstdint>
+#include <iosfwd>
+
+#include "Simulation.h"
+
+namespace digest {
+using Value = std::uint64_t;
+
+class Hasher {
+public:
+    Hasher();
+    void add(std::uint64_t word);
+    void add(double value);  // its bits, -0.0 and 0.0 differ
+    void add(long long value);
+    Value value() const;
+
+private:
+    Value state;
+};
+
+Value of(const Algae& algae);
+Value of(const Coral& coral);
+Value of(const Scavenger& scavenger);
+
+struct TickDigest {
+    unsigned long tick;
+    Value total;  // of the four below
+    Value algae;
+    Value corals;
+    Value scavengers;
+    Value random;  // random engine, next coral ID, mode and seed if COUNTER
+};
+TickDigest compute(const Simulation& simulation);
+
+void writeHeader(std::ostream& out);
+void write(std::ostream& out, const TickDigest& digest);
+void writeEntities(std::ostream& out, const Simulation& simulation);
+
+// reads two digest streams and writes to report the first tick where they differ,
+// which parts differ and, when both have the entity lines, the first entity that
+// differs; true when they are identical
+bool compare(std::istream& first, std::istream& second, std::ostream& report);
+}  // namespace digest
+
+#endif  // DIGEST_H
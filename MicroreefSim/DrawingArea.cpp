@@ -11,6 +11,9 @@
  *              - Drawing entities such as algae, coral, and scavengers
  *              - Applying transformations for correct scaling and positioning
  *              - Responding to resize events to adjust drawings appropriately
+ *              - Keeping dead corals and boundaries in a cached image layer
+ *              - Batched rendering: one path and one stroke per style
+ *              - Zoom (mouse wheel) and pan (drag), culling and level of detail
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -19,23 +22,97 @@
 
 #include "DrawingArea.h"
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+
 Frame DrawingArea::Default_Frame = {0., 256., 0., 256., 1, 500, 500};
 //{xMin, xMax, yMin, yMax, aspect ratio, width, height}
 
-DrawingArea::DrawingArea() : simulation(nullptr) {
+constexpr double min_zoom(0.25);
+constexpr double max_zoom(64.0);
+// below this diameter on screen, in device pixels, the ring of an algae can no
+// longer be told apart and the algae are drawn as a density instead
+constexpr double algae_ring_min_pixels(3.0);
+
+DrawingArea::DrawingArea()
+    : simulation(nullptr),
+      zoom(1.0),
+      view_center{max / 2, max / 2},
+      drag_start_center(view_center),
+      static_layer_valid(false),
+      static_layer_revision(0),
+      static_layer_scale(1) {
     setFrame(Default_Frame);
     set_content_width(Default_Frame.width);
     set_content_height(Default_Frame.height);
     set_draw_func(sigc::mem_fun(*this, &DrawingArea::on_draw));
+
+    auto scroll = Gtk::EventControllerScroll::create();
+    scroll->set_flags(Gtk::EventControllerScroll::Flags::VERTICAL);
+    scroll->signal_scroll().connect(sigc::mem_fun(*this, &DrawingArea::on_scroll),
+                                    false);
+    add_controller(scroll);
+
+    auto drag = Gtk::GestureDrag::create();
+    drag->signal_drag_begin().connect(
+        sigc::mem_fun(*this, &DrawingArea::on_drag_begin));
+    drag->signal_drag_update().connect(
+        sigc::mem_fun(*this, &DrawingArea::on_drag_update));
+    add_controller(drag);
 }
 
 DrawingArea::~DrawingArea() {}
 
 void DrawingArea::updateSimulationData(const Simulation& simulation_) {
+    if (simulation != &simulation_) {
+        invalidate_static_layer();
+    }
     simulation = &simulation_;
     queue_draw();  // Redraw when simulation data is updated
 }
 
+void DrawingArea::invalidate_static_layer() {
+    static_layer_valid = false;
+}
+
+void DrawingArea::zoom_by(double factor) {
+    zoom = std::clamp(zoom * factor, min_zoom, max_zoom);
+    invalidate_static_layer();  // the static content moved on screen
+    queue_draw();
+}
+
+void DrawingArea::pan_by(double dx, double dy) {
+    // pixels to world units, y goes up in the world and down on screen
+    double pixel = pixel_size(frame);
+    view_center.x = std::clamp(view_center.x - dx * pixel, 0.0, max);
+    view_center.y = std::clamp(view_center.y + dy * pixel, 0.0, max);
+    invalidate_static_layer();
+    queue_draw();
+}
+
+void DrawingArea::reset_view() {
+    zoom = 1.0;
+    view_center = {max / 2, max / 2};
+    invalidate_static_layer();
+    queue_draw();
+}
+
+bool DrawingArea::on_scroll(double, double dy) {
+    zoom_by(dy < 0 ? 1.25 : 0.8);  // wheel up zooms in
+    return true;
+}
+
+void DrawingArea::on_drag_begin(double, double) {
+    drag_start_center = view_center;
+}
+
+void DrawingArea::on_drag_update(double dx, double dy) {
+    // dx, dy are measured from where the drag began
+    view_center = drag_start_center;
+    pan_by(dx, dy);
+}
+
 void DrawingArea::setFrame(const Frame& frame_) {
     // check if the frame is correct
     // check if theres an incoherence in the frame
@@ -50,8 +127,24 @@ void DrawingArea::setFrame(const Frame& frame_) {
 }
 
 void DrawingArea::adjustFrame(int width, int height) {
+    frame = zoomed_frame(fitted_frame(width, height), zoom, view_center);
+}
+
+Frame DrawingArea::zoomed_frame(const Frame& fitted, double zoom, const S2d& center) {
+    Frame zoomed = fitted;
+    double half_width = (fitted.xMax - fitted.xMin) / (2 * zoom);
+    double half_height = (fitted.yMax - fitted.yMin) / (2 * zoom);
+    zoomed.xMin = center.x - half_width;
+    zoomed.xMax = center.x + half_width;
+    zoomed.yMin = center.y - half_height;
+    zoomed.yMax = center.y + half_height;
+    return zoomed;
+}
+
+Frame DrawingArea::fitted_frame(int width, int height) {
     // voir la serie
     // this function is used to adjust the frame to the window size
+    Frame frame = Default_Frame;
     frame.width = width - 20;    // Subtract margins from total width
     frame.height = height - 20;  // Subtract margins from total height
 
@@ -82,18 +175,60 @@ void DrawingArea::adjustFrame(int width, int height) {
         frame.yMin =
             mid - 0.5 * (Default_Frame.aspect_ratio / new_aspect_ratio) * delta;
     }
+    return frame;
 }
 
 void DrawingArea::on_draw(const Cairo::RefPtr<Cairo::Context>& cr, int width,
                           int height) {
     adjustFrame(width, height);
+    refresh_static_layer(width, height);
+
+    // the layer is in device coordinates, paint it before the projection
+    cr->save();
+    cr->set_source(static_layer, 0, 0);
+    cr->paint();
+    cr->restore();
+
     orthographic_projection(cr, frame);
-    drawBoundaries(cr, width, height);
     if (simulation != nullptr) {
-        draw_all_entities(cr, simulation->get_algae_in_simulation(),
-                          simulation->get_coral_in_simulation(),
-                          simulation->get_scavenger_in_simulation());
+        draw_dynamic_entities(cr, frame, simulation->get_algae_in_simulation(),
+                              simulation->get_coral_in_simulation(),
+                              simulation->get_scavenger_in_simulation());
+    }
+}
+
+void DrawingArea::refresh_static_layer(int width, int height) {
+    unsigned long revision = simulation ? simulation->getStaticRevision() : 0;
+    // one pixel of the layer per device pixel, so it stays sharp on HiDPI displays
+    int scale = std::max(get_scale_factor(), 1);
+    bool same_size = static_layer && static_layer_scale == scale &&
+                     static_layer->get_width() == width * scale &&
+                     static_layer->get_height() == height * scale;
+    if (static_layer_valid && same_size && static_layer_revision == revision) {
+        return;  // nothing static changed since the last frame
+    }
+    if (!same_size) {
+        static_layer = Cairo::ImageSurface::create(Cairo::Surface::Format::ARGB32,
+                                                   width * scale, height * scale);
+        static_layer->set_device_scale(scale, scale);
+        static_layer_scale = scale;
+    }
+
+    auto layer_cr = Cairo::Context::create(static_layer);
+    layer_cr->set_operator(Cairo::Context::Operator::CLEAR);  // start transparent
+    layer_cr->paint();
+    layer_cr->set_operator(Cairo::Context::Operator::OVER);
+
+    orthographic_projection(layer_cr, frame);
+    drawBoundaries(layer_cr, width, height);
+    if (simulation != nullptr) {
+        draw_corals_batched(layer_cr, frame, simulation->get_coral_in_simulation(),
+                            DEAD);
     }
+    static_layer->flush();
+
+    static_layer_revision = revision;
+    static_layer_valid = true;
 }
 
 void DrawingArea::orthographic_projection(const Cairo::RefPtr<Cairo::Context>& cr,
@@ -175,19 +310,205 @@ Colors::Blue()); } else { drawSegment(cr, segment, Colors::Red());
     }
 } */
 
+void DrawingArea::draw_all_entities_unbatched(
+    const Cairo::RefPtr<Cairo::Context>& cr, const std::vector<Algae>& algae,
+    const std::vector<Coral>& corals, const std::vector<Scavenger>& scavengers) {
+    for (const Algae& algae_ : algae) {
+        draw_an_algae(cr, algae_);
+    }
+
+    for (const Coral& coral : corals) {
+        draw_a_coral(cr, coral);
+    }
+
+    for (const Scavenger& scavenger : scavengers) {
+        draw_a_scavenger(cr, scavenger);
+    }
+}
+
 void DrawingArea::draw_all_entities(const Cairo::RefPtr<Cairo::Context>& cr,
+                                    const Frame& frame,
                                     const std::vector<Algae>& algae,
                                     const std::vector<Coral>& corals,
                                     const std::vector<Scavenger>& scavengers) {
+    draw_algae_batched(cr, frame, algae);
+    draw_corals_batched(cr, frame, corals, ALIVE);
+    draw_corals_batched(cr, frame, corals, DEAD);
+    draw_scavengers_batched(cr, frame, scavengers);
+}
+
+void DrawingArea::draw_dynamic_entities(const Cairo::RefPtr<Cairo::Context>& cr,
+                                        const Frame& frame,
+                                        const std::vector<Algae>& algae,
+                                        const std::vector<Coral>& corals,
+                                        const std::vector<Scavenger>& scavengers) {
+    draw_algae_batched(cr, frame, algae);
+    // dead ones come from the static layer
+    draw_corals_batched(cr, frame, corals, ALIVE);
+    draw_scavengers_batched(cr, frame, scavengers);
+}
+
+double DrawingArea::pixel_size(const Frame& frame) {
+    return (frame.xMax - frame.xMin) / std::max(frame.width, 1);
+}
+
+double DrawingArea::device_pixel_size(const Cairo::RefPtr<Cairo::Context>& cr) {
+    // includes the device scale of the surface, the scale factor of a HiDPI display
+    // when cr draws on it directly
+    double dx(1), dy(0);
+    cr->user_to_device_distance(dx, dy);
+    double pixels = std::hypot(dx, dy);
+    return pixels > 0 ? 1 / pixels : 1;
+}
+
+bool DrawingArea::is_visible(const Frame& frame, double x, double y,
+                             double margin) {
+    return is_box_visible(frame, {x - margin, y - margin}, {x + margin, y + margin});
+}
+
+bool DrawingArea::is_box_visible(const Frame& frame, const S2d& low,
+                                 const S2d& high) {
+    return high.x >= frame.xMin && low.x <= frame.xMax && high.y >= frame.yMin &&
+           low.y <= frame.yMax;
+}
+
+void DrawingArea::draw_algae_batched(const Cairo::RefPtr<Cairo::Context>& cr,
+                                     const Frame& frame,
+                                     const std::vector<Algae>& algae) {
+    if (algae.empty()) {
+        return;
+    }
+    double diameter(2. * r_alg);
+    double device_pixel = device_pixel_size(cr);
+    if (diameter < algae_ring_min_pixels * device_pixel) {
+        // cells the size of an algae, or of a pixel once an algae is smaller
+        draw_algae_density(cr, frame, algae, std::max(diameter, device_pixel));
+        return;
+    }
+    beginStyle(cr, Colors::Green(), r_alg * 0.5);
     for (const Algae& algae_ : algae) {
-        draw_an_algae(cr, algae_);
+        S2d position = algae_.getPosition();
+        if (is_visible(frame, position.x, position.y, r_alg)) {
+            appendCircle(cr, position.x, position.y, r_alg);
+        }
+    }
+    strokeStyle(cr);
+}
+
+void DrawingArea::draw_algae_density(const Cairo::RefPtr<Cairo::Context>& cr,
+                                     const Frame& frame,
+                                     const std::vector<Algae>& algae, double cell) {
+    // count the algae falling in each cell of the view and fill the cells, the
+    // more algae in a cell the more opaque it is
+    int columns = std::max(1, static_cast<int>((frame.xMax - frame.xMin) / cell) + 1);
+    int rows = std::max(1, static_cast<int>((frame.yMax - frame.yMin) / cell) + 1);
+    std::vector<unsigned> density(static_cast<size_t>(columns) * rows, 0);
+    for (const Algae& algae_ : algae) {
+        S2d position = algae_.getPosition();
+        if (!is_visible(frame, position.x, position.y, 0)) {
+            continue;
+        }
+        int column = static_cast<int>((position.x - frame.xMin) / cell);
+        int row = static_cast<int>((position.y - frame.yMin) / cell);
+        if (column < columns && row < rows) {
+            ++density[static_cast<size_t>(row) * columns + column];
+        }
     }
 
+    constexpr double level_alpha[] = {0.35, 0.65, 1.0};  // 1, 2-3, 4+ algae
+    Color green = Colors::Green();
+    for (int level = 0; level < 3; ++level) {
+        cr->save();
+        cr->set_source_rgba(green.red, green.green, green.blue, level_alpha[level]);
+        cr->begin_new_path();
+        for (int row = 0; row < rows; ++row) {
+            for (int column = 0; column < columns; ++column) {
+                unsigned count = density[static_cast<size_t>(row) * columns + column];
+                int count_level = (count >= 4) ? 2 : (count >= 2) ? 1 : 0;
+                if (count > 0 && count_level == level) {
+                    cr->rectangle(frame.xMin + column * cell, frame.yMin + row * cell,
+                                  cell, cell);
+                }
+            }
+        }
+        cr->fill();
+        cr->restore();
+    }
+}
+
+void DrawingArea::draw_corals_batched(const Cairo::RefPtr<Cairo::Context>& cr,
+                                      const Frame& frame,
+                                      const std::vector<Coral>& corals,
+                                      Statut_cor statut) {
+    if (std::none_of(corals.begin(), corals.end(), [statut](const Coral& coral) {
+            return coral.getStatut() == statut;
+        })) {
+        return;
+    }
+    Color color = (statut == ALIVE) ? Colors::Blue() : Colors::Black();
+    double pixel = device_pixel_size(cr);
+
+    // all the segments in one stroke, each coral as one polyline where the joints
+    // closer than a device pixel to the previous kept one are merged
+    std::vector<S2d> joints;  // reused for every coral
+    beginStyle(cr, color, 1.0);
     for (const Coral& coral : corals) {
-        draw_a_coral(cr, coral);
+        const SegmentVector& segments = coral.getSegments();
+        if (coral.getStatut() != statut || segments.empty()) {
+            continue;
+        }
+        joints.clear();
+        joints.push_back(segments.front().getBase());
+        S2d low = joints.back(), high = joints.back();  // bounding box
+        for (size_t i = 0; i < segments.size(); ++i) {
+            S2d joint = segments[i].calculate_extremite();
+            low = {std::min(low.x, joint.x), std::min(low.y, joint.y)};
+            high = {std::max(high.x, joint.x), std::max(high.y, joint.y)};
+            if (i + 1 < segments.size() &&
+                std::fabs(joint.x - joints.back().x) < pixel &&
+                std::fabs(joint.y - joints.back().y) < pixel) {
+                continue;  // tiny segment, merged with the next one
+            }
+            joints.push_back(joint);
+        }
+        if (!is_box_visible(frame, low, high)) {
+            continue;
+        }
+        cr->move_to(joints.front().x, joints.front().y);
+        for (size_t i = 1; i < joints.size(); ++i) {
+            cr->line_to(joints[i].x, joints[i].y);
+        }
     }
+    strokeStyle(cr);
 
+    // ...and all the base squares in another, their line width is different
+    beginStyle(cr, color, d_cor * 0.5);
+    for (const Coral& coral : corals) {
+        S2d base = coral.getPosition();
+        if (coral.getStatut() == statut && is_visible(frame, base.x, base.y, d_cor)) {
+            appendSquare(cr, base.x, base.y, d_cor);
+        }
+    }
+    strokeStyle(cr);
+}
+
+void DrawingArea::draw_scavengers_batched(const Cairo::RefPtr<Cairo::Context>& cr,
+                                          const Frame& frame,
+                                          const std::vector<Scavenger>& scavengers) {
+    // the line width depends on the radius, so one stroke per radius (there are
+    // only a handful of them between r_sca and r_sca_repro)
+    std::map<double, std::vector<S2d>> by_radius;
     for (const Scavenger& scavenger : scavengers) {
-        draw_a_scavenger(cr, scavenger);
+        S2d position = scavenger.getPosition();
+        if (is_visible(frame, position.x, position.y, scavenger.getRadius())) {
+            by_radius[scavenger.getRadius()].push_back(position);
+        }
+    }
+    for (const auto& [radius, positions] : by_radius) {
+        beginStyle(cr, Colors::Red(), radius * 0.5);
+        for (const S2d& position : positions) {
+            appendCircle(cr, position.x, position.y, radius);
+        }
+        strokeStyle(cr);
     }
 }
@@ -11,6 +11,10 @@
  *              - Drawing different types of entities with distinct visual styles
  *              - Handling resize events to maintain aspect ratio
  *              - Integrating closely with the simulation data to update visuals
+ *              - Caching the static content (boundaries, dead corals) in an image
+ *              - Batching all shapes of one style into a single stroke
+ *              - Zoom and pan, with culling of what is outside of the view and a
+ *                level of detail for what is too small on screen to be told apart
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -20,6 +24,10 @@
 #ifndef DRAWING_AREA_H
 #define DRAWING_AREA_H
 
+#include <cairomm/surface.h>
+#include <gtkmm/eventcontrollerscroll.h>
+#include <gtkmm/gesturedrag.h>
+
 #include "GenericDrawing.h"
 #include "Simulation.h"
 
@@ -41,26 +49,88 @@ public:
     void setFrame(const Frame& frame);
     void adjustFrame(int width, int height);
     void updateSimulationData(const Simulation& simulation);
+    // frame showing the whole world in a width x height area without distorsion
+    static Frame fitted_frame(int width, int height);
+    // the fitted frame zoomed by zoom (1 = whole world) around center
+    static Frame zoomed_frame(const Frame& fitted, double zoom, const S2d& center);
+    static void orthographic_projection(const Cairo::RefPtr<Cairo::Context>& cr,
+                                        const Frame& frame);
+
+    // view controls (mouse wheel, drag, or the window keyboard shortcuts)
+    void zoom_by(double factor);
+    void pan_by(double dx, double dy);  // in pixels
+    void reset_view();
+
+    // one entity at a time (one stroke per shape)
+    static void draw_an_algae(const Cairo::RefPtr<Cairo::Context>& cr,
+                              const Algae& algae);
+    static void draw_a_coral(const Cairo::RefPtr<Cairo::Context>& cr,
+                             const Coral& coral);
+    static void draw_a_scavenger(const Cairo::RefPtr<Cairo::Context>& cr,
+                                 const Scavenger& scavenger);
+    static void draw_all_entities_unbatched(const Cairo::RefPtr<Cairo::Context>& cr,
+                                            const std::vector<Algae>& algae,
+                                            const std::vector<Coral>& corals,
+                                            const std::vector<Scavenger>& scavengers);
 
-    void draw_an_algae(const Cairo::RefPtr<Cairo::Context>& cr, const Algae& algae);
-    void draw_a_coral(const Cairo::RefPtr<Cairo::Context>& cr, const Coral& coral);
-    void draw_a_scavenger(const Cairo::RefPtr<Cairo::Context>& cr,
-                          const Scavenger& scavenger);
+    // batched, one stroke per style (algae, living/dead segments, scavengers...),
+    // only what is visible in frame is drawn, with less detail below a few device
+    // pixels
+    static void draw_all_entities(const Cairo::RefPtr<Cairo::Context>& cr,
+                                  const Frame& frame, const std::vector<Algae>& algae,
+                                  const std::vector<Coral>& corals,
+                                  const std::vector<Scavenger>& scavengers);
+    // everything that can change from one update to the next (no dead corals)
+    static void draw_dynamic_entities(const Cairo::RefPtr<Cairo::Context>& cr,
+                                      const Frame& frame,
+                                      const std::vector<Algae>& algae,
+                                      const std::vector<Coral>& corals,
+                                      const std::vector<Scavenger>& scavengers);
+    static void draw_algae_batched(const Cairo::RefPtr<Cairo::Context>& cr,
+                                   const Frame& frame,
+                                   const std::vector<Algae>& algae);
+    // the algae counted in square cells of side cell, in world units
+    static void draw_algae_density(const Cairo::RefPtr<Cairo::Context>& cr,
+                                   const Frame& frame,
+                                   const std::vector<Algae>& algae, double cell);
+    static void draw_corals_batched(const Cairo::RefPtr<Cairo::Context>& cr,
+                                    const Frame& frame,
+                                    const std::vector<Coral>& corals,
+                                    Statut_cor statut);  // only corals in statut
+    static void draw_scavengers_batched(const Cairo::RefPtr<Cairo::Context>& cr,
+                                        const Frame& frame,
+                                        const std::vector<Scavenger>& scavengers);
+    void invalidate_static_layer();
 
-    void draw_all_entities(const Cairo::RefPtr<Cairo::Context>& cr,
-                           const std::vector<Algae>& algae,
-                           const std::vector<Coral>& corals,
-                           const std::vector<Scavenger>& scavengers);
+    static double pixel_size(const Frame& frame);  // world units per pixel
+    // world units per pixel of the device cr draws on, after its projection;
+    // smaller than pixel_size on a HiDPI display
+    static double device_pixel_size(const Cairo::RefPtr<Cairo::Context>& cr);
+    // true if the box [x - margin, x + margin] x [y - margin, y + margin] is seen
+    static bool is_visible(const Frame& frame, double x, double y, double margin);
+    static bool is_box_visible(const Frame& frame, const S2d& low, const S2d& high);
 
 protected:
     void on_draw(const Cairo::RefPtr<Cairo::Context>& cr, int width, int height);
-    static void orthographic_projection(const Cairo::RefPtr<Cairo::Context>& cr,
-                                        const Frame& frame);
 
 private:
     Frame frame;  // holds current frame settings
     const Simulation* simulation;
     static Frame Default_Frame;  // frame of reference
+
+    double zoom;      // 1 shows the whole world, 2 half of it...
+    S2d view_center;  // world point at the center of the view
+    S2d drag_start_center;
+    bool on_scroll(double dx, double dy);
+    void on_drag_begin(double x, double y);
+    void on_drag_update(double dx, double dy);
+
+    // boundaries and dead corals rendered once, repainted only when they change
+    Cairo::RefPtr<Cairo::ImageSurface> static_layer;
+    bool static_layer_valid;
+    unsigned long static_layer_revision;  // simulation revision it was drawn at
+    int static_layer_scale;  // device pixels per pixel of the widget
+    void refresh_static_layer(int width, int height);
 };
 
 #endif  // DRAWING_AREA_H
@@ -0,0 +1,76 @@
+/**
+ * File: FileLoader.cpp
+ * ---------------------
+ * Description: Implements the FileLoader class from FileLoader.h.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "FileLoader.h"
+
+#include <cmath>
+
+FileLoader::FileLoader() : cancel_requested(false), done(false), progress(0.0) {}
+
+FileLoader::~FileLoader() {
+    cancel();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void FileLoader::start(const std::string& filename, std::function<void()> notify) {
+    if (worker.joinable()) {
+        cancel();
+        take();
+    }
+    cancel_requested = false;
+    done = false;
+    progress = 0.0;
+    worker = std::thread(&FileLoader::read, this, filename, std::move(notify));
+}
+
+void FileLoader::cancel() {
+    cancel_requested = true;
+}
+
+bool FileLoader::isBusy() const {
+    return worker.joinable();
+}
+
+bool FileLoader::isDone() const {
+    return done;
+}
+
+double FileLoader::getProgress() const {
+    return progress;
+}
+
+std::unique_ptr<Simulation> FileLoader::take() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+    return std::move(result);
+}
+
+void FileLoader::read(std::string filename, std::function<void()> notify) {
+    auto simulation = std::make_unique<Simulation>();
+    int percent(0);
+    bool read = simulation->start(filename, [&](double fraction) {
+        progress = fraction;
+        int now = static_cast<int>(std::floor(fraction * 100));
+        if (now != percent) {
+            percent = now;
+            notify();
+        }
+        return !cancel_requested;
+    });
+    if (read && !cancel_requested) {
+        result = std::move(simulation);
+    }
+    progress = 1.0;
+    done = true;
+    notify();
+}
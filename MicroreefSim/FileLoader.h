@@ -0,0 +1,58 @@
+/**
+ * File: FileLoader.h
+ * -------------------
+ * Description: Defines the FileLoader class, which reads a file into a new
+ *              Simulation on a worker thread so the window keeps running the
+ *              current one meanwhile. The reading and its validation are O(n²) in
+ *              the number of corals, a large reef froze the window for seconds.
+ *
+ *              The worker only touches the Simulation it creates, the caller
+ *              polls the progress, may cancel, and takes the result once the
+ *              worker is done (Simulation::replaceWith swaps it in).
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef FILE_LOADER_H
+#define FILE_LOADER_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "Simulation.h"
+
+class FileLoader {
+public:
+    FileLoader();
+    ~FileLoader();  // cancels the reading and waits for the worker
+
+    // starts reading filename, notify is called from the worker whenever the
+    // progress moves by a percent and once when it is done; a reading that was
+    // not taken yet is cancelled first
+    void start(const std::string& filename, std::function<void()> notify);
+    void cancel();  // the worker stops at its next progress report
+
+    bool isBusy() const;  // started and not taken yet
+    bool isDone() const;  // take will not block
+    double getProgress() const;  // 0 to 1
+
+    // waits for the worker; the simulation read, or nullptr when the file could
+    // not be opened or the reading was cancelled
+    std::unique_ptr<Simulation> take();
+
+private:
+    std::thread worker;
+    std::atomic<bool> cancel_requested;
+    std::atomic<bool> done;
+    std::atomic<double> progress;
+    std::unique_ptr<Simulation> result;  // written by the worker before done
+
+    void read(std::string filename, std::function<void()> notify);  // worker
+};
+
+#endif  // FILE_LOADER_H
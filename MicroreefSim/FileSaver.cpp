@@ -0,0 +1,58 @@
+/**
+ * File: FileSaver.cpp
+ * --------------------
+ * Description: Implements the FileSaver class from FileSaver.h.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "FileSaver.h"
+
+FileSaver::FileSaver()
+    : done(false),
+      saved(false),
+      snapshot{{}, {}, {}, 0, {}, 0, Simulation::ENGINE, 1} {}
+
+FileSaver::~FileSaver() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+bool FileSaver::start(const Simulation& simulation, const std::string& filename_,
+                      std::function<void()> notify) {
+    // the snapshot is about to be overwritten
+    bool previous_saved = !worker.joinable() || finish();
+    simulation.takeSnapshot(snapshot);
+    filename = filename_;
+    done = false;
+    worker = std::thread(&FileSaver::write, this, std::move(notify));
+    return previous_saved;
+}
+
+bool FileSaver::isBusy() const {
+    return worker.joinable();
+}
+
+bool FileSaver::isDone() const {
+    return done;
+}
+
+bool FileSaver::finish() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+    return saved;
+}
+
+const std::string& FileSaver::getFilename() const {
+    return filename;
+}
+
+void FileSaver::write(std::function<void()> notify) {
+    saved = Simulation::saveSnapshot(snapshot, filename);
+    done = true;
+    notify();
+}
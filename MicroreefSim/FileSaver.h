@@ -0,0 +1,58 @@
+/**
+ * File: FileSaver.h
+ * ------------------
+ * Description: Defines the FileSaver class, which saves a Simulation without
+ *              making the window or the simulation wait for the disk. start copies
+ *              the entities (Simulation::takeSnapshot, one copy of the vectors, far
+ *              cheaper than formatting them) and a worker thread writes the copy
+ *              while the simulation keeps being updated.
+ *
+ *              The snapshot is kept between saves so its storage is reused. It is
+ *              only copied and freed on the calling thread, the worker only reads
+ *              it: the segments of the corals then go back to the pool of the
+ *              calling thread and not to the one of a thread that ends (Pool.h).
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef FILE_SAVER_H
+#define FILE_SAVER_H
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "Simulation.h"
+
+class FileSaver {
+public:
+    FileSaver();
+    ~FileSaver();  // waits for the save in progress
+
+    // copies the state of simulation now and writes it to filename on the worker,
+    // notify is called from the worker once the file is written; waits for the
+    // previous save first if it was not finished, and returns false when that
+    // one could not be written so that its failure is not lost
+    bool start(const Simulation& simulation, const std::string& filename,
+               std::function<void()> notify);
+
+    bool isBusy() const;  // started and not finished yet
+    bool isDone() const;  // finish will not block
+    // waits for the worker; false when the file could not be opened or written
+    bool finish();
+    const std::string& getFilename() const;  // of the last save started
+
+private:
+    std::thread worker;
+    std::atomic<bool> done;
+    bool saved;  // written by the worker before done
+    Simulation::Snapshot snapshot;
+    std::string filename;
+
+    void write(std::function<void()> notify);  // worker
+};
+
+#endif  // FILE_SAVER_H
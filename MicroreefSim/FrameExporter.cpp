@@ -0,0 +1,150 @@
+/**
+ * File: FrameExporter.cpp
+ * ------------------------
+ * Description: Implements the FrameExporter class from FrameExporter.h. Frames are
+ *              drawn on the calling thread (the simulation is not thread safe) into
+ *              recycled image surfaces, then handed to the worker threads through a
+ *              bounded queue protected by a mutex. Each worker writes whole PNG
+ *              files, Cairo allows different surfaces to be used from different
+ *              threads.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "FrameExporter.h"
+
+#include <cairomm/context.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <system_error>
+
+#include "DrawingArea.h"
+
+FrameExporter::FrameExporter(const std::string& directory_, unsigned threads,
+                             int width_, int height_, size_t max_pending_)
+    : directory(directory_),
+      width(width_),
+      height(height_),
+      max_pending(std::max<size_t>(max_pending_, 1)),
+      stopping(false),
+      in_progress(0),
+      frames_queued(0),
+      frames_written(0) {
+    std::error_code code;
+    std::filesystem::create_directories(directory, code);
+    if (code) {
+        setError("cannot create " + directory + ": " + code.message());
+    }
+    for (unsigned i = 0; i < std::max(threads, 1u); ++i) {
+        workers.emplace_back(&FrameExporter::encodeFrames, this);
+    }
+}
+
+FrameExporter::~FrameExporter() {
+    finish();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    job_ready.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void FrameExporter::exportFrame(const Simulation& simulation) {
+    if (!getError().empty()) {
+        return;
+    }
+    auto surface = takeSurface();
+    auto cr = Cairo::Context::create(surface);
+    cr->set_source_rgb(1.0, 1.0, 1.0);  // a png has no window background
+    cr->paint();
+
+    Frame frame = DrawingArea::fitted_frame(width, height);
+    DrawingArea::orthographic_projection(cr, frame);
+    DrawingArea::drawBoundaries(cr, width, height);
+    DrawingArea::draw_all_entities(cr, frame, simulation.get_algae_in_simulation(),
+                                   simulation.get_coral_in_simulation(),
+                                   simulation.get_scavenger_in_simulation());
+    surface->flush();
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%06lu.png", frames_queued);
+    ++frames_queued;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back({surface, directory + "/" + name});
+    }
+    job_ready.notify_one();
+}
+
+Cairo::RefPtr<Cairo::ImageSurface> FrameExporter::takeSurface() {
+    std::unique_lock<std::mutex> lock(mutex);
+    // back pressure: wait for the encoders when too many frames are pending
+    job_done.wait(lock, [this] { return jobs.size() + in_progress < max_pending; });
+    if (!free_surfaces.empty()) {
+        auto surface = free_surfaces.back();
+        free_surfaces.pop_back();
+        return surface;
+    }
+    return Cairo::ImageSurface::create(Cairo::Surface::Format::ARGB32, width, height);
+}
+
+void FrameExporter::encodeFrames() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        job_ready.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) {
+            return;  // stopping and nothing left to write
+        }
+        Job job = jobs.front();
+        jobs.pop_front();
+        ++in_progress;
+
+        lock.unlock();
+        // an exception must not leave the thread, std::terminate would end the
+        // program
+        try {
+            job.surface->write_to_png(job.filename);
+            ++frames_written;
+        } catch (const std::exception& failure) {
+            setError("cannot write " + job.filename + ": " + failure.what());
+        }
+        lock.lock();
+
+        --in_progress;
+        free_surfaces.push_back(job.surface);
+        job_done.notify_all();
+    }
+}
+
+void FrameExporter::finish() {
+    std::unique_lock<std::mutex> lock(mutex);
+    job_done.wait(lock, [this] { return jobs.empty() && in_progress == 0; });
+}
+
+unsigned long FrameExporter::getFramesQueued() const {
+    return frames_queued;
+}
+
+unsigned long FrameExporter::getFramesWritten() const {
+    return frames_written;
+}
+
+std::string FrameExporter::getError() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return error;
+}
+
+void FrameExporter::setError(const std::string& message) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (error.empty()) {
+        error = message;
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * File: FrameExporter.h
+ * ----------------------
+ * Description: Defines the FrameExporter class, which renders the state of a
+ *              Simulation on an offscreen Cairo image surface with the same drawing
+ *              code as the window (DrawingArea, GenericDrawing) and writes it to a
+ *              numbered PNG file. The rendering is done by the caller, the PNG
+ *              encoding by a pool of background threads so the simulation loop
+ *              does not wait for the disk. The number of frames waiting for their
+ *              encoding is bounded, the caller only blocks when it is reached.
+ *
+ *              An error (the directory cannot be created, a PNG cannot be written)
+ *              does not stop the program: the first one is kept for getError and
+ *              the frames after it are dropped.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef FRAME_EXPORTER_H
+#define FRAME_EXPORTER_H
+
+#include <cairomm/surface.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Simulation.h"
+
+class FrameExporter {
+public:
+    FrameExporter(const std::string& directory, unsigned threads, int width = 500,
+                  int height = 500, size_t max_pending = 16);
+    ~FrameExporter();  // waits for the frames still being encoded
+
+    // renders the simulation now and queues the PNG frame_<number>.png, nothing
+    // once an error happened
+    void exportFrame(const Simulation& simulation);
+    void finish();  // blocks until every queued frame is written
+
+    unsigned long getFramesQueued() const;
+    unsigned long getFramesWritten() const;
+    std::string getError() const;  // the first error, empty if none
+
+private:
+    struct Job {
+        Cairo::RefPtr<Cairo::ImageSurface> surface;
+        std::string filename;
+    };
+
+    std::string directory;
+    int width;
+    int height;
+    size_t max_pending;  // frames rendered but not yet encoded
+
+    std::vector<std::thread> workers;
+    std::deque<Job> jobs;
+    std::vector<Cairo::RefPtr<Cairo::ImageSurface>> free_surfaces;  // recycled
+    mutable std::mutex mutex;  // getError reads error
+    std::condition_variable job_ready;
+    std::condition_variable job_done;
+    bool stopping;
+    size_t in_progress;
+    std::string error;
+
+    unsigned long frames_queued;
+    std::atomic<unsigned long> frames_written;
+
+    void encodeFrames();  // worker thread loop
+    Cairo::RefPtr<Cairo::ImageSurface> takeSurface();
+    void setError(const std::string& message);  // keeps the first one
+};
+
+#endif  // FRAME_EXPORTER_H
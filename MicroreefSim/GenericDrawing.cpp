@@ -66,12 +66,8 @@ void GenericDrawing::drawSegment(const Cairo::RefPtr<Cairo::Context>& cr,
                                  const Segment& segment,
                                  const Color& color) {  // blue by default
 
-    // multiply the length by 5 to make it bigger for asthetic reasons
-    Segment tempSegment = segment;
-    tempSegment.setLength(segment.getLength());
-
-    S2d base = tempSegment.getBase();
-    S2d extremite = tempSegment.calculate_extremite();
+    S2d base = segment.getBase();
+    S2d extremite = segment.calculate_extremite();
 
     // double squareSide = d_cor;  // Side length of the square at the base, d_cor
 
@@ -114,3 +110,39 @@ void GenericDrawing::drawBoundaries(const Cairo::RefPtr<Cairo::Context>& cr, int
     cr->stroke();
     cr->restore();
 }
+
+// The line widths below follow the single shape methods: half the radius for a
+// circle, half the side for a square and 1 for a segment.
+void GenericDrawing::beginStyle(const Cairo::RefPtr<Cairo::Context>& cr,
+                                const Color& color, double line_width) {
+    cr->save();
+    cr->set_source_rgb(color.red, color.green, color.blue);
+    cr->set_line_width(line_width);
+    cr->begin_new_path();
+}
+
+void GenericDrawing::appendCircle(const Cairo::RefPtr<Cairo::Context>& cr, double x,
+                                  double y, double radius) {
+    // start a sub path on the circle so it is not joined to the previous shape
+    cr->move_to(x + radius, y);
+    cr->arc(x, y, radius, 0, 2 * M_PI);
+}
+
+void GenericDrawing::appendSquare(const Cairo::RefPtr<Cairo::Context>& cr, double x,
+                                  double y, double side) {
+    double half_side = side / 2;
+    cr->rectangle(x - half_side, y - half_side, side, side);  // own sub path
+}
+
+void GenericDrawing::appendSegment(const Cairo::RefPtr<Cairo::Context>& cr,
+                                   const Segment& segment) {
+    S2d base = segment.getBase();
+    S2d extremite = segment.calculate_extremite();
+    cr->move_to(base.x, base.y);
+    cr->line_to(extremite.x, extremite.y);
+}
+
+void GenericDrawing::strokeStyle(const Cairo::RefPtr<Cairo::Context>& cr) {
+    cr->stroke();  // one stroke for every shape appended since beginStyle
+    cr->restore();
+}
@@ -6,6 +6,10 @@
  *              Gtk::DrawingArea that provides generic drawing functionalities such
  *              as drawing circles, squares, segments, and boundaries. This class
  *              serves as a base class for more specialized drawing operations.
+ *              The drawing methods only use the given context, they are static so
+ *              they can also render on offscreen surfaces without a widget.
+ *              Besides the one-shape-per-call methods, the append* methods only add
+ *              to the current path so many shapes of one style share one stroke.
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -24,16 +28,28 @@ class GenericDrawing : public Gtk::DrawingArea {
 public:
     GenericDrawing();
     virtual ~GenericDrawing();
-    void drawCircle(const Cairo::RefPtr<Cairo::Context>& cr, double x, double y,
-                    double radius, const Color& color);
-    void drawSquare(const Cairo::RefPtr<Cairo::Context>& cr, double x, double y,
-                    double side, const Color& color);  // Method to draw a square
+    static void drawCircle(const Cairo::RefPtr<Cairo::Context>& cr, double x,
+                           double y, double radius, const Color& color);
+    static void drawSquare(const Cairo::RefPtr<Cairo::Context>& cr, double x,
+                           double y, double side,
+                           const Color& color);  // Method to draw a square
 
-    void drawSegment(const Cairo::RefPtr<Cairo::Context>& cr, const Segment& segment,
-                     const Color& color);
+    static void drawSegment(const Cairo::RefPtr<Cairo::Context>& cr,
+                            const Segment& segment, const Color& color);
 
-    void drawBoundaries(const Cairo::RefPtr<Cairo::Context>& cr, int width,
-                        int height);
+    static void drawBoundaries(const Cairo::RefPtr<Cairo::Context>& cr, int width,
+                               int height);
+
+    // batched drawing: beginStyle, any number of append*, then strokeStyle
+    static void beginStyle(const Cairo::RefPtr<Cairo::Context>& cr,
+                           const Color& color, double line_width);
+    static void appendCircle(const Cairo::RefPtr<Cairo::Context>& cr, double x,
+                             double y, double radius);
+    static void appendSquare(const Cairo::RefPtr<Cairo::Context>& cr, double x,
+                             double y, double side);
+    static void appendSegment(const Cairo::RefPtr<Cairo::Context>& cr,
+                              const Segment& segment);
+    static void strokeStyle(const Cairo::RefPtr<Cairo::Context>& cr);
 };
 
 #endif  // GENERIC_DRAWING_H
\ No newline at end of file
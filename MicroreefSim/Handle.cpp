@@ -0,0 +1,102 @@
+/**
+ * File: Handle.cpp
+ * -----------------
+ * Description: Implements the Handle struct and the HandleTable class from
+ *              Handle.h.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "Handle.h"
+
+#include <algorithm>
+
+namespace {
+constexpr unsigned int hole(~0u);  // in slot_at, at a position removed
+}  // namespace
+
+bool Handle::operator==(const Handle& other) const {
+    return slot == other.slot && generation == other.generation;
+}
+
+bool Handle::operator!=(const Handle& other) const {
+    return !(*this == other);
+}
+
+HandleTable::HandleTable() : first_removed(~size_t(0)) {}
+
+Handle HandleTable::add() {
+    unsigned int position = slot_at.size();
+    unsigned int slot;
+    if (free_slots.empty()) {
+        slot = slots.size();
+        slots.push_back({position, 0});
+    } else {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        slots[slot].position = position;
+    }
+    slot_at.push_back(slot);
+    return {slot, slots[slot].generation};
+}
+
+void HandleTable::clear() {
+    for (unsigned int slot : slot_at) {
+        if (slot != hole) {
+            ++slots[slot].generation;
+            free_slots.push_back(slot);
+        }
+    }
+    slot_at.clear();
+    first_removed = ~size_t(0);
+}
+
+void HandleTable::remove(size_t position) {
+    release(position);
+    slot_at[position] = hole;
+    first_removed = std::min(first_removed, position);
+}
+
+bool HandleTable::isRemoved(size_t position) const {
+    return slot_at[position] == hole;
+}
+
+size_t HandleTable::firstRemoved() const {
+    return std::min(first_removed, slot_at.size());
+}
+
+void HandleTable::release(size_t position) {
+    unsigned int slot = slot_at[position];
+    ++slots[slot].generation;  // the handles given out so far become stale
+    free_slots.push_back(slot);
+}
+
+void HandleTable::move(size_t from, size_t to) {
+    slot_at[to] = slot_at[from];
+    slots[slot_at[to]].position = to;
+}
+
+void HandleTable::truncate(size_t size) {
+    slot_at.resize(size);
+    first_removed = ~size_t(0);  // the compaction closed the holes
+}
+
+bool HandleTable::isValid(Handle handle) const {
+    return handle.slot < slots.size() &&
+           slots[handle.slot].generation == handle.generation;
+}
+
+size_t HandleTable::position(Handle handle) const {
+    return slots[handle.slot].position;
+}
+
+Handle HandleTable::handleAt(size_t position) const {
+    unsigned int slot = slot_at[position];
+    return {slot, slots[slot].generation};
+}
+
+size_t HandleTable::size() const {
+    return slot_at.size();
+}
@@ -0,0 +1,86 @@
+/**
+ * File: Handle.h
+ * ---------------
+ * Description: Defines the handles of the entities of the Simulation and the
+ *              HandleTable that resolves them.
+ *
+ *              The entities live by value in vectors whose order matters (it is
+ *              the order of the updates and of the saved file), so their position
+ *              changes whenever an entity before them is removed. A handle names a
+ *              slot of the table instead, and the slot follows the entity when it
+ *              moves: finding an entity from its handle is O(1) and no longer needs
+ *              operator== or a search by ID.
+ *
+ *              When an entity is removed its slot gets a new generation and goes to
+ *              the free list. A handle kept from before carries the old generation,
+ *              so it is detected as stale instead of naming whatever entity reuses
+ *              the slot later.
+ *
+ *              The table does not hold the entities, the owner of the vector calls
+ *              add, remove, release, move and truncate so the table mirrors every
+ *              change of the vector.
+ *
+ *              Erasing from the middle of the vector shifts everything after it,
+ *              so removals are marked instead: remove makes the handles of the
+ *              entity stale at once and leaves a hole at its position, skipped by
+ *              the loops of the owner, and one compaction pass later closes all
+ *              the holes, the order of the others kept.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef HANDLE_H
+#define HANDLE_H
+
+#include <cstddef>
+#include <vector>
+
+struct Handle {
+    unsigned int slot;
+    unsigned int generation;
+
+    bool operator==(const Handle& other) const;
+    bool operator!=(const Handle& other) const;
+};
+
+constexpr Handle no_handle{~0u, 0};  // names nothing, never valid
+
+class HandleTable {
+public:
+    HandleTable();
+    Handle add();  // for the entity just appended to the vector
+    void clear();
+
+    // the entity at position is to be removed: its handles are stale from now on,
+    // it stays in the vector as a hole until the next compaction
+    void remove(size_t position);
+    bool isRemoved(size_t position) const;
+    // where the compaction has to start, size() when there is no hole
+    size_t firstRemoved() const;
+
+    // for a pass that compacts the vector in place: release the positions
+    // removed (not the holes, already released), move the kept ones down, then
+    // truncate to the new size
+    void release(size_t position);
+    void move(size_t from, size_t to);
+    void truncate(size_t size);
+
+    bool isValid(Handle handle) const;
+    size_t position(Handle handle) const;  // only for a valid handle
+    Handle handleAt(size_t position) const;
+    size_t size() const;  // entities tracked, the size of the vector
+
+private:
+    struct Slot {
+        unsigned int position;
+        unsigned int generation;
+    };
+    std::vector<Slot> slots;
+    std::vector<unsigned int> free_slots;
+    std::vector<unsigned int> slot_at;  // slot of the entity at each position
+    size_t first_removed;  // the first hole, slot_at.size() or more if none
+};
+
+#endif  // HANDLE_H
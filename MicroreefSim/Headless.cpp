@@ -0,0 +1,977 @@
+/**
+ * File: Headless.cpp
+ * -------------------
+ * Description: Implements the command line modes declared in Headless.h. They load
+ *              a configuration file into a Simulation, run it without any window
+ *              and report their results on the standard output.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "Headless.h"
+
+#include <cairomm/context.h>
+#include <cairomm/surface.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "Assignment.h"
+#include "Digest.h"
+#include "DrawingArea.h"
+#include "FrameExporter.h"
+#include "MetricsRecorder.h"
+#include "Pool.h"
+#include "Stats.h"
+#include "Timeline.h"
+#include "Trace.h"
+#include "Trajectory.h"
+
+namespace {
+constexpr int frame_width(500);  // same drawing size as the window
+constexpr int frame_height(500);
+constexpr unsigned long golden_checkpoint(100);  // updates between golden lines
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [file.txt]\n"
+              << "       " << program
+              << " --run <file.txt> <ticks> [output.txt] [--metrics <file.csv>]"
+              << " [--record <file.traj>]\n"
+              << "       " << program << " --replay <file.traj> <tick> [output.txt]\n"
+              << "       " << program
+              << " --digest <file.txt> <ticks> [output.txt] [--entities]\n"
+              << "       " << program << " --compare-digests <first.txt> <second.txt>\n"
+              << "       " << program
+              << " --golden <record|verify> <directory of t*.txt> [ticks]\n"
+              << "       " << program << " --bench-trajectory <file.txt> [ticks]\n"
+              << "       " << program
+              << " --bench-timeline <file.txt> [ticks] [megabytes]\n"
+              << "       " << program << " --bench-render <file.txt> [frames] [ticks]\n"
+              << "       " << program << " --bench-alloc <file.txt> [ticks]\n"
+              << "       " << program
+              << " --bench-fork <file.txt> [branches] [ticks]\n"
+              << "       " << program << " --bench-footprint [entities]\n"
+              << "       " << program << " --bench-assign [scavengers] [corals]\n"
+              << "       " << program << " --bench-feeding [scavengers] [ticks]\n"
+              << "       " << program
+              << " --export-frames <file.txt> <ticks> <every> <directory> [threads]\n"
+              << "options: --birth (algae birth on), --trace <file.json>,\n"
+              << "         --global-assign (scavenger targets matched globally),\n"
+              << "         --counter-random (draws from the tick and entity id)"
+              << std::endl;
+}
+
+// removes flag from args, returns whether it was there
+bool take_flag(std::vector<std::string>& args, const std::string& flag) {
+    auto it = std::find(args.begin(), args.end(), flag);
+    if (it == args.end()) {
+        return false;
+    }
+    args.erase(it);
+    return true;
+}
+
+// removes option and its value from args, returns the value or "" if absent
+std::string take_option(std::vector<std::string>& args, const std::string& option) {
+    auto it = std::find(args.begin(), args.end(), option);
+    if (it == args.end() || it + 1 == args.end()) {
+        return "";
+    }
+    std::string value = *(it + 1);
+    args.erase(it, it + 2);
+    return value;
+}
+
+// optional unsigned argument at position index, fallback if it is missing
+unsigned long argument_or(const std::vector<std::string>& args, size_t index,
+                          unsigned long fallback) {
+    if (index < args.size()) {
+        return std::strtoul(args[index].c_str(), nullptr, 10);
+    }
+    return fallback;
+}
+
+// the lines of a golden file: at tick 0 and every golden_checkpoint updates, the
+// digest of the state then the chain of the digests of all the updates so far
+void golden_lines(Simulation& simulation, unsigned long ticks,
+                  std::vector<std::string>& lines) {
+    digest::Hasher chain;
+    std::ostringstream line;
+    for (unsigned long tick = 0; tick <= ticks; ++tick) {
+        if (tick > 0) {
+            simulation.updateEntities();
+        }
+        digest::TickDigest state = digest::compute(simulation);
+        chain.add(state.total);
+        if (tick % golden_checkpoint == 0 || tick == ticks) {
+            line.str("");
+            digest::write(line, state);
+            std::string text = line.str();
+            text.pop_back();  // newline
+            line.str("");
+            line << text << ' ' << std::hex << std::setw(16) << std::setfill('0')
+                 << chain.value() << std::dec;
+            lines.push_back(line.str());
+        }
+    }
+}
+
+// what differs between two golden lines, by column name
+std::string golden_difference(const std::string& expected, const std::string& actual) {
+    static const char* columns[] = {"tick",       "total",  "algae", "corals",
+                                    "scavengers", "random", "chain"};
+    std::istringstream a(expected), b(actual);
+    std::string differs;
+    for (const char* column : columns) {
+        std::string x, y;
+        a >> x;
+        b >> y;
+        if (x != y) {
+            differs += std::string(" ") + column;
+        }
+    }
+    return differs;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// loads the file, runs it for ticks updates with algae birth on so the benchmarks
+// can be done on a populated reef; false when the file cannot be opened
+bool prepare_simulation(Simulation& simulation, const std::string& config_file,
+                        unsigned ticks) {
+    if (!simulation.start(config_file)) {
+        return false;
+    }
+    if (ticks > 0) {
+        simulation.setAlgaeBirthAllowed(true);
+        for (unsigned i = 0; i < ticks; ++i) {
+            simulation.updateEntities();
+        }
+    }
+    return true;
+}
+
+// average time in milliseconds to draw one frame of the simulation
+double time_frames(const Simulation& simulation, unsigned frames, bool batched) {
+    auto surface = Cairo::ImageSurface::create(Cairo::Surface::Format::ARGB32,
+                                               frame_width, frame_height);
+    Frame frame = DrawingArea::fitted_frame(frame_width, frame_height);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < frames; ++i) {
+        auto cr = Cairo::Context::create(surface);
+        cr->set_source_rgb(1.0, 1.0, 1.0);
+        cr->paint();
+        DrawingArea::orthographic_projection(cr, frame);
+        DrawingArea::drawBoundaries(cr, frame_width, frame_height);
+        if (batched) {
+            DrawingArea::draw_all_entities(cr, frame,
+                                           simulation.get_algae_in_simulation(),
+                                           simulation.get_coral_in_simulation(),
+                                           simulation.get_scavenger_in_simulation());
+        } else {
+            DrawingArea::draw_all_entities_unbatched(
+                cr, simulation.get_algae_in_simulation(),
+                simulation.get_coral_in_simulation(),
+                simulation.get_scavenger_in_simulation());
+        }
+        surface->flush();
+    }
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return frames > 0 ? elapsed.count() / frames : 0.0;
+}
+
+// free scavengers and dead corals of one segment at random places, seeded so every
+// call builds the same reef; the positions are returned in the order of the vectors
+void make_assignment_reef(Simulation& simulation, unsigned scavengers,
+                          unsigned corals, std::vector<S2d>& seekers,
+                          std::vector<S2d>& bases) {
+    std::default_random_engine engine(1);
+    std::uniform_real_distribution<double> position(2 * l_repro, max - 2 * l_repro);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    simulation.reset_simulation();
+    for (unsigned id = 1; id <= corals; ++id) {
+        S2d base{position(engine), position(engine)};
+        simulation.add_Coral_To_Simulation(
+            Coral(base, 1, id, DEAD, TRIGO, EXTEND, 1, angle(engine), l_repro));
+        bases.push_back(base);
+    }
+    for (unsigned i = 0; i < scavengers; ++i) {
+        S2d at{position(engine), position(engine)};
+        simulation.add_Scavenger_To_Simulation(Scavenger(at, 1));
+        seekers.push_back(at);
+    }
+}
+
+// one dead coral of one segment per scavenger, the scavenger already eating at its
+// end; the radii are spread so about one scavenger in seven divides per update
+void make_feeding_reef(Simulation& simulation, unsigned scavengers) {
+    std::default_random_engine engine(1);
+    std::uniform_real_distribution<double> position(2 * l_repro, max - 2 * l_repro);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    simulation.reset_simulation();
+    for (unsigned id = 1; id <= scavengers; ++id) {
+        S2d base{position(engine), position(engine)};
+        Coral coral(base, 1, id, DEAD, TRIGO, EXTEND, 1, angle(engine), l_repro);
+        S2d end = coral.get_last_segment().calculate_extremite();
+        simulation.add_Coral_To_Simulation(std::move(coral));
+        double radius = r_sca + id % (r_sca_repro - r_sca);
+        simulation.add_Scavenger_To_Simulation(Scavenger(end, 1, radius, MANGE, id));
+    }
+}
+
+// memory of count records, and what it was when each record carried a vptr
+template <class Records>
+void report_footprint(const char* name, const Records& records) {
+    using T = typename Records::value_type;
+    constexpr double mib(1024.0 * 1024.0);
+    size_t with_vptr = sizeof(T) + sizeof(void*);
+    std::cout << name << ": " << sizeof(T) << " bytes (" << with_vptr
+              << " with a vptr), " << records.size() * sizeof(T) / mib
+              << " MiB instead of " << records.size() * with_vptr / mib << " MiB"
+              << std::endl;
+}
+
+// average time in milliseconds to copy the records, a memmove when they are trivial
+template <class Records>
+double time_copy(const Records& records, unsigned repeats) {
+    Records copy(records);
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < repeats; ++i) {
+        std::copy(records.begin(), records.end(), copy.begin());
+    }
+    return seconds_since(start) * 1000 / repeats;
+}
+}  // namespace
+
+bool headless::run(int argc, char** argv, int& status) {
+    if (argc < 2 || std::string(argv[1]).rfind("--", 0) != 0) {
+        return false;  // no mode asked, open the window
+    }
+    std::string mode = argv[1];
+    std::vector<std::string> args(argv + 2, argv + argc);  // after the mode
+    bool algae_birth = take_flag(args, "--birth");
+    bool global_assignment = take_flag(args, "--global-assign");
+    bool counter_random = take_flag(args, "--counter-random");
+    bool entity_digests = take_flag(args, "--entities");
+    std::string trace_file = take_option(args, "--trace");
+    std::string metrics_file = take_option(args, "--metrics");
+    std::string record_file = take_option(args, "--record");
+    trace::set_enabled(!trace_file.empty());
+
+    if (mode == "--run" && args.size() >= 2) {
+        std::string output_file = args.size() > 2 ? args[2] : "";
+        status = run_ticks(args[0], argument_or(args, 1, 0), output_file, metrics_file,
+                           record_file, algae_birth, global_assignment,
+                           counter_random);
+    } else if (mode == "--replay" && args.size() >= 2) {
+        std::string output_file = args.size() > 2 ? args[2] : "";
+        status = replay(args[0], argument_or(args, 1, 0), output_file);
+    } else if (mode == "--digest" && args.size() >= 2) {
+        std::string output_file = args.size() > 2 ? args[2] : "";
+        status = write_digests(args[0], argument_or(args, 1, 0), output_file,
+                               entity_digests, algae_birth, global_assignment,
+                               counter_random);
+    } else if (mode == "--compare-digests" && args.size() >= 2) {
+        status = compare_digests(args[0], args[1]);
+    } else if (mode == "--golden" && args.size() >= 2 &&
+               (args[0] == "record" || args[0] == "verify")) {
+        status = golden(args[0] == "record", args[1], argument_or(args, 2, 1000));
+    } else if (mode == "--bench-trajectory" && args.size() >= 1) {
+        status = benchmark_trajectory(args[0], argument_or(args, 1, 1000), algae_birth);
+    } else if (mode == "--bench-timeline" && args.size() >= 1) {
+        unsigned long default_megabytes = Timeline::default_budget >> 20;
+        status = benchmark_timeline(args[0], argument_or(args, 1, 1000),
+                                    argument_or(args, 2, default_megabytes),
+                                    algae_birth);
+    } else if (mode == "--bench-render" && args.size() >= 1) {
+        status = benchmark_rendering(args[0], argument_or(args, 1, 100),
+                                     argument_or(args, 2, 0));
+    } else if (mode == "--bench-alloc" && args.size() >= 1) {
+        status = benchmark_allocations(args[0], argument_or(args, 1, 1000));
+    } else if (mode == "--bench-fork" && args.size() >= 1) {
+        status = benchmark_fork(args[0], argument_or(args, 1, 100),
+                                argument_or(args, 2, 100));
+    } else if (mode == "--bench-footprint") {
+        status = benchmark_footprint(argument_or(args, 0, 1000000));
+    } else if (mode == "--bench-feeding") {
+        status =
+            benchmark_feeding(argument_or(args, 0, 10000), argument_or(args, 1, 10));
+    } else if (mode == "--bench-assign") {
+        status = benchmark_assignment(argument_or(args, 0, 2000),
+                                      argument_or(args, 1, 2000));
+    } else if (mode == "--export-frames" && args.size() >= 4) {
+        unsigned default_threads = std::max(1u, std::thread::hardware_concurrency());
+        status = export_frames(args[0], argument_or(args, 1, 0),
+                               std::max(1ul, argument_or(args, 2, 1)), args[3],
+                               argument_or(args, 4, default_threads), algae_birth);
+    } else {
+        print_usage(argv[0]);
+        status = EXIT_FAILURE;
+    }
+
+    if (!trace_file.empty()) {
+        trace::set_enabled(false);
+        if (!trace::flush(trace_file)) {
+            std::cerr << "Error: Unable to write the trace to " << trace_file
+                      << std::endl;
+            status = EXIT_FAILURE;
+        }
+    }
+    return true;
+}
+
+int headless::run_ticks(const std::string& config_file, unsigned long ticks,
+                        const std::string& output_file,
+                        const std::string& metrics_file,
+                        const std::string& record_file, bool algae_birth,
+                        bool global_assignment, bool counter_random) {
+    Simulation simulation;
+    if (!simulation.start(config_file)) {
+        return EXIT_FAILURE;
+    }
+    simulation.setAlgaeBirthAllowed(algae_birth);
+    if (global_assignment) {
+        simulation.setAssignment(Simulation::GLOBAL);
+    }
+    if (counter_random) {
+        simulation.setRandomMode(Simulation::COUNTER);
+    }
+
+    MetricsRecorder metrics;
+    if (!metrics_file.empty() && !metrics.open(metrics_file)) {
+        std::cerr << "Error: Unable to open file " << metrics_file << " for writing."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    TrajectoryRecorder recorder;
+    if (!record_file.empty() && !recorder.open(record_file)) {
+        std::cerr << "Error: Unable to open file " << record_file << " for writing."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    recorder.record(simulation);  // the state read, tick 0
+    // run again without the tracer from the same state to measure what it costs
+    bool measure_tracer =
+        trace::is_enabled() && !metrics.isOpen() && !recorder.isOpen();
+    Simulation untraced = measure_tracer ? simulation.fork() : Simulation();
+
+    auto start = std::chrono::steady_clock::now();
+    if (metrics.isOpen() || recorder.isOpen()) {
+        for (unsigned long tick = 1; tick <= ticks; ++tick) {
+            auto tick_start = std::chrono::steady_clock::now();
+            simulation.updateEntities();
+            if (metrics.isOpen()) {
+                metrics.record(simulation, tick, seconds_since(tick_start) * 1000);
+            }
+            recorder.record(simulation);
+        }
+        metrics.close();
+        recorder.close();
+    } else {
+        simulation.runTicks(ticks);  // skips the idle updates
+    }
+    double seconds = seconds_since(start);
+    std::cout << ticks << " updates in " << seconds << " s, "
+              << simulation.getAlgaeCount() << " algae, " << simulation.getCoralCount()
+              << " corals, " << simulation.getScavengerCount() << " scavengers"
+              << std::endl;
+    if (measure_tracer) {
+        trace::set_enabled(false);
+        auto untraced_start = std::chrono::steady_clock::now();
+        untraced.runTicks(ticks);
+        double untraced_seconds = seconds_since(untraced_start);
+        trace::set_enabled(true);
+        std::cout << "without the tracer: " << untraced_seconds
+                  << " s, the tracer costs " << (seconds / untraced_seconds - 1) * 100
+                  << " %, "
+                  << trace::dropped_events() << " events dropped" << std::endl;
+    }
+
+    if (!output_file.empty()) {
+        simulation.saveSimulation(output_file);
+    }
+    return EXIT_SUCCESS;
+}
+
+int headless::replay(const std::string& trajectory_file, unsigned long tick,
+                     const std::string& output_file) {
+    TrajectoryPlayer player;
+    if (!player.open(trajectory_file)) {
+        std::cerr << "Error: " << trajectory_file << " is not a trajectory."
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto start = std::chrono::steady_clock::now();
+    if (!player.seek(tick)) {
+        std::cerr << "Error: tick " << tick << " is not in " << trajectory_file
+                  << " (ticks " << player.getFirstTick() << " to "
+                  << player.getLastTick() << ")." << std::endl;
+        return EXIT_FAILURE;
+    }
+    const Simulation::Snapshot& state = player.getState();
+    std::cout << "tick " << state.tick << " of " << player.getFrameCount()
+              << " frames in " << seconds_since(start) * 1000 << " ms, "
+              << state.algae.size() << " algae, " << state.corals.size()
+              << " corals, " << state.scavengers.size() << " scavengers" << std::endl;
+    if (!output_file.empty() && !Simulation::saveSnapshot(state, output_file)) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int headless::write_digests(const std::string& config_file, unsigned long ticks,
+                            const std::string& output_file, bool entities,
+                            bool algae_birth, bool global_assignment,
+                            bool counter_random) {
+    Simulation simulation;
+    if (!simulation.start(config_file)) {
+        return EXIT_FAILURE;
+    }
+    simulation.setAlgaeBirthAllowed(algae_birth);
+    if (global_assignment) {
+        simulation.setAssignment(Simulation::GLOBAL);
+    }
+    if (counter_random) {
+        simulation.setRandomMode(Simulation::COUNTER);
+    }
+    std::ofstream file;
+    if (!output_file.empty()) {
+        file.open(output_file);
+        if (!file) {
+            std::cerr << "Error: Unable to open file " << output_file
+                      << " for writing." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream& out = output_file.empty() ? std::cout : file;
+
+    double update_seconds(0);
+    double digest_seconds(0);
+    digest::writeHeader(out);
+    for (unsigned long tick = 0; tick <= ticks; ++tick) {
+        if (tick > 0) {
+            auto update_start = std::chrono::steady_clock::now();
+            simulation.updateEntities();
+            update_seconds += seconds_since(update_start);
+        }
+        auto digest_start = std::chrono::steady_clock::now();
+        digest::TickDigest digest = digest::compute(simulation);
+        digest_seconds += seconds_since(digest_start);
+        digest::write(out, digest);
+        if (entities) {
+            digest::writeEntities(out, simulation);
+        }
+    }
+    if (!output_file.empty()) {  // the stream is on the standard output otherwise
+        std::cout << ticks << " updates: "
+                  << update_seconds * 1000 / std::max(ticks, 1ul)
+                  << " ms/update, digest " << digest_seconds * 1000 / (ticks + 1)
+                  << " ms/update" << std::endl;
+    }
+    return out ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int headless::compare_digests(const std::string& first_file,
+                              const std::string& second_file) {
+    std::ifstream first(first_file);
+    std::ifstream second(second_file);
+    if (!first || !second) {
+        std::cerr << "Error: Unable to open file "
+                  << (!first ? first_file : second_file) << std::endl;
+        return EXIT_FAILURE;
+    }
+    return digest::compare(first, second, std::cout) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int headless::golden(bool record, const std::string& directory,
+                     unsigned long ticks) {
+    namespace fs = std::filesystem;
+    std::vector<fs::path> scenarios;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() > 5 && name[0] == 't' && entry.path().extension() == ".txt") {
+            scenarios.push_back(entry.path());
+        }
+    }
+    if (error || scenarios.empty()) {
+        std::cerr << "Error: no t*.txt file in " << directory << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::sort(scenarios.begin(), scenarios.end());
+    fs::path golden_directory = fs::path(directory) / "golden";
+    if (record) {
+        fs::create_directories(golden_directory, error);
+    }
+
+    unsigned failures(0);
+    unsigned checked(0);
+    for (const auto& scenario : scenarios) {
+        for (bool algae_birth : {false, true}) {
+            Simulation simulation;
+            // without the messages of the reading
+            std::streambuf* output = std::cout.rdbuf(nullptr);
+            std::streambuf* errors = std::cerr.rdbuf(nullptr);
+            bool read = simulation.start(scenario.string());
+            std::cout.rdbuf(output);
+            std::cerr.rdbuf(errors);
+            if (!read || !simulation.getReadFileSuccess()) {
+                break;  // an invalid file, its dynamics are those of an empty reef
+            }
+            simulation.setAlgaeBirthAllowed(algae_birth);
+            std::vector<std::string> lines;
+            golden_lines(simulation, ticks, lines);
+
+            std::string run = scenario.stem().string() + (algae_birth ? "_birth" : "");
+            fs::path golden_file = golden_directory / (run + ".txt");
+            if (record) {
+                std::ofstream file(golden_file);
+                file << "# " << scenario.filename().string() << ", algae birth "
+                     << (algae_birth ? "on" : "off") << ", " << ticks << " updates\n"
+                     << "# tick total algae corals scavengers random chain\n";
+                for (const auto& line : lines) {
+                    file << line << '\n';
+                }
+                if (!file) {
+                    std::cerr << "Error: Unable to write " << golden_file << std::endl;
+                    ++failures;
+                }
+                ++checked;
+                continue;
+            }
+
+            std::ifstream file(golden_file);
+            std::vector<std::string> expected;
+            for (std::string line; std::getline(file, line);) {
+                if (!line.empty() && line[0] != '#') {
+                    expected.push_back(line);
+                }
+            }
+            ++checked;
+            if (expected.empty()) {
+                std::cout << run << ": no golden file " << golden_file << std::endl;
+                ++failures;
+                continue;
+            }
+            size_t common = std::min(expected.size(), lines.size());
+            size_t first = std::mismatch(lines.begin(), lines.begin() + common,
+                                         expected.begin())
+                               .first -
+                           lines.begin();
+            if (first == common && expected.size() == lines.size()) {
+                continue;
+            }
+            ++failures;
+            if (first == common) {
+                std::cout << run << ": " << expected.size() << " golden lines, "
+                          << lines.size() << " run, record with the same ticks"
+                          << std::endl;
+                continue;
+            }
+            auto tick_of = [](const std::string& line) {
+                return line.substr(0, line.find(' '));
+            };
+            std::cout << run << ": differs ";
+            if (first == 0) {
+                std::cout << "once read:";
+            } else {
+                std::cout << "between tick " << tick_of(lines[first - 1]) << " and "
+                          << tick_of(lines[first]) << ":";
+            }
+            std::cout << golden_difference(expected[first], lines[first]) << std::endl;
+        }
+    }
+    if (record) {
+        std::cout << checked << " golden runs recorded in " << golden_directory.string()
+                  << std::endl;
+    } else if (failures == 0) {
+        std::cout << checked << " golden runs identical" << std::endl;
+    } else {
+        std::cout << failures << " of " << checked << " golden runs differ, "
+                  << "--digest and --compare-digests find the update and entity"
+                  << std::endl;
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int headless::benchmark_trajectory(const std::string& config_file,
+                                   unsigned long ticks, bool algae_birth) {
+    const std::string trajectory_file("bench_trajectory.traj");
+    const std::string snapshot_file("bench_trajectory.txt");
+    Simulation recorded;
+    Simulation saved;
+    if (!recorded.start(config_file) || !saved.start(config_file)) {
+        return EXIT_FAILURE;
+    }
+    recorded.setAlgaeBirthAllowed(algae_birth);
+    saved.setAlgaeBirthAllowed(algae_birth);
+
+    // the same run twice, the updates alone are timed in both
+    TrajectoryRecorder recorder;
+    if (!recorder.open(trajectory_file)) {
+        return EXIT_FAILURE;
+    }
+    double update_seconds(0);
+    auto start = std::chrono::steady_clock::now();
+    recorder.record(recorded);
+    for (unsigned long tick = 0; tick < ticks; ++tick) {
+        auto update_start = std::chrono::steady_clock::now();
+        recorded.updateEntities();
+        update_seconds += seconds_since(update_start);
+        recorder.record(recorded);
+    }
+    recorder.close();
+    double record_seconds = seconds_since(start) - update_seconds;
+
+    unsigned long long snapshot_bytes(0);
+    double saved_update_seconds(0);
+    start = std::chrono::steady_clock::now();
+    for (unsigned long tick = 0; tick <= ticks; ++tick) {
+        if (tick > 0) {
+            auto update_start = std::chrono::steady_clock::now();
+            saved.updateEntities();
+            saved_update_seconds += seconds_since(update_start);
+        }
+        saved.saveSimulation(snapshot_file);
+        std::ifstream written(snapshot_file, std::ios::binary | std::ios::ate);
+        snapshot_bytes += written.tellg();
+    }
+    double save_seconds = seconds_since(start) - saved_update_seconds;
+
+    TrajectoryPlayer player;
+    double seek_ms(0);
+    if (player.open(trajectory_file)) {
+        start = std::chrono::steady_clock::now();
+        player.seek(ticks);
+        player.seek(ticks / 2);
+        seek_ms = seconds_since(start) * 1000 / 2;
+    }
+    std::remove(trajectory_file.c_str());
+    std::remove(snapshot_file.c_str());
+
+    double per_tick = 1000.0 / (ticks + 1);
+    std::cout << ticks << " updates: " << update_seconds * 1000 / std::max(ticks, 1ul)
+              << " ms/update\n"
+              << "saveSimulation per update: " << snapshot_bytes << " bytes, "
+              << save_seconds * per_tick << " ms/update\n"
+              << "trajectory: " << recorder.getBytesWritten() << " bytes, "
+              << record_seconds * per_tick << " ms/update, "
+              << recorder.getFramesWritten() << " frames\n"
+              << "size: " << 100.0 * recorder.getBytesWritten() / snapshot_bytes
+              << "% of the snapshots, time: "
+              << 100.0 * record_seconds / std::max(save_seconds, 1e-9) << "%\n"
+              << "seek: " << seek_ms << " ms" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int headless::benchmark_timeline(const std::string& config_file, unsigned long ticks,
+                                 unsigned long megabytes, bool algae_birth) {
+    Simulation simulation;
+    if (!simulation.start(config_file)) {
+        return EXIT_FAILURE;
+    }
+    simulation.setAlgaeBirthAllowed(algae_birth);
+    Timeline timeline(megabytes << 20);
+    double update_seconds(0);
+    auto start = std::chrono::steady_clock::now();
+    timeline.record(simulation);
+    for (unsigned long tick = 0; tick < ticks; ++tick) {
+        auto update_start = std::chrono::steady_clock::now();
+        simulation.updateEntities();
+        update_seconds += seconds_since(update_start);
+        timeline.record(simulation);
+    }
+    double record_seconds = seconds_since(start) - update_seconds;
+    std::cout << "kept ticks " << timeline.getFirstTick() << " to "
+              << timeline.getLastTick() << " in "
+              << timeline.getMemoryUsed() / double(1 << 20) << " of " << megabytes
+              << " MB, " << record_seconds * 1000 / (ticks + 1)
+              << " ms/update to record" << std::endl;
+
+    // as the slider does: back by some updates, then one update forward
+    Simulation past;
+    for (unsigned long back : {1ul, 10ul, 100ul, 500ul, ticks}) {
+        if (back > timeline.getLastTick() - timeline.getFirstTick()) {
+            continue;
+        }
+        unsigned long tick = timeline.getLastTick() - back;
+        start = std::chrono::steady_clock::now();
+        timeline.seek(tick);
+        double seek_ms = seconds_since(start) * 1000;
+        start = std::chrono::steady_clock::now();
+        timeline.seek(tick + 1);
+        double step_ms = seconds_since(start) * 1000;
+        start = std::chrono::steady_clock::now();
+        past.restore(timeline.getState());
+        double restore_ms = seconds_since(start) * 1000;
+        std::cout << "back " << back << ": seek " << seek_ms << " ms, next update "
+                  << step_ms << " ms, restore " << restore_ms << " ms" << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
+
+int headless::benchmark_fork(const std::string& config_file, unsigned branches,
+                             unsigned long ticks) {
+    auto start = std::chrono::steady_clock::now();
+    Simulation parsed;
+    if (!parsed.start(config_file) || !parsed.getReadFileSuccess()) {
+        return EXIT_FAILURE;
+    }
+    double read_ms = seconds_since(start) * 1000;
+
+    std::vector<Simulation> forks;
+    forks.reserve(branches);
+    start = std::chrono::steady_clock::now();
+    for (unsigned branch = 0; branch < branches; ++branch) {
+        forks.push_back(parsed.fork());
+    }
+    double fork_ms = seconds_since(start) * 1000 / std::max(branches, 1u);
+    std::cout << parsed.getAlgaeCount() << " algae, " << parsed.getCoralCount()
+              << " corals, " << parsed.getScavengerCount() << " scavengers: read "
+              << read_ms << " ms, fork " << fork_ms << " ms" << std::endl;
+    if (fork_ms > 0) {
+        std::cout << "speedup: x" << read_ms / fork_ms << std::endl;
+    }
+
+    std::vector<digest::Value> finals;
+    start = std::chrono::steady_clock::now();
+    for (unsigned branch = 0; branch < branches; ++branch) {
+        forks[branch].setRandomSeed(branch + 1);
+        forks[branch].setAlgaeBirthAllowed(true);
+        forks[branch].runTicks(ticks);
+        finals.push_back(digest::compute(forks[branch]).total);
+    }
+    double run_ms = seconds_since(start) * 1000 / std::max(branches, 1u);
+    std::sort(finals.begin(), finals.end());
+    size_t distinct = std::unique(finals.begin(), finals.end()) - finals.begin();
+    std::cout << branches << " branches of " << ticks << " updates, " << run_ms
+              << " ms each, " << distinct << " distinct final states" << std::endl;
+
+    // seed 1 is the seed of a file read, that branch is the run of the file
+    if (branches > 0) {
+        Simulation read_again;
+        read_again.start(config_file);
+        read_again.setAlgaeBirthAllowed(true);
+        read_again.runTicks(ticks);
+        bool same = digest::compute(read_again).total ==
+                    digest::compute(forks[0]).total;
+        std::cout << "branch of seed 1 against the file read again: "
+                  << (same ? "identical" : "DIFFERENT") << std::endl;
+        if (!same) {
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+int headless::benchmark_rendering(const std::string& config_file, unsigned frames,
+                                  unsigned ticks) {
+    Simulation simulation;
+    if (!prepare_simulation(simulation, config_file, ticks)) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "entities: " << simulation.getAlgaeCount() << " algae, "
+              << simulation.getCoralCount() << " corals, "
+              << simulation.getScavengerCount() << " scavengers" << std::endl;
+
+    double unbatched = time_frames(simulation, frames, false);
+    double batched = time_frames(simulation, frames, true);
+    std::cout << "one stroke per entity: " << unbatched << " ms/frame\n"
+              << "one stroke per style:  " << batched << " ms/frame" << std::endl;
+    if (batched > 0) {
+        std::cout << "speedup: x" << unbatched / batched << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
+
+int headless::benchmark_allocations(const std::string& config_file,
+                                    unsigned long ticks) {
+    Simulation simulation;
+    if (!simulation.start(config_file)) {
+        return EXIT_FAILURE;
+    }
+    simulation.setAlgaeBirthAllowed(true);
+
+    unsigned long long allocations(0);
+    pool::Counters before = pool::counters();
+    for (unsigned long tick = 0; tick < ticks; ++tick) {
+        simulation.updateEntities();
+        allocations += simulation.getLastTickStats().counters[stats::ALLOCATIONS];
+    }
+    const pool::Counters& after = pool::counters();
+    double per_tick = ticks > 0 ? 1.0 / ticks : 0.0;
+
+    std::cout << "entities: " << simulation.getAlgaeCount() << " algae, "
+              << simulation.getCoralCount() << " corals, "
+              << simulation.getScavengerCount() << " scavengers" << std::endl;
+    if (stats::enabled) {
+        std::cout << "operator new: " << allocations * per_tick << " per update"
+                  << std::endl;
+    } else {
+        std::cout << "operator new: not counted, build with MICROREEF_STATS"
+                  << std::endl;
+    }
+    std::cout << "segment pool, per update: "
+              << (after.reused - before.reused) * per_tick << " blocks reused, "
+              << (after.carved - before.carved) * per_tick << " carved, "
+              << (after.oversized - before.oversized) * per_tick << " oversized\n"
+              << "segment pool chunks: " << after.chunks - before.chunks << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int headless::benchmark_footprint(unsigned long entities) {
+    if (entities == 0) {
+        return EXIT_SUCCESS;
+    }
+    constexpr unsigned repeats(10);
+    std::vector<Algae> algae;
+    std::vector<Scavenger> scavengers;
+    SegmentVector segments;
+    algae.reserve(entities);
+    scavengers.reserve(entities);
+    segments.reserve(entities);
+    for (unsigned long i = 0; i < entities; ++i) {
+        unsigned long side(max);
+        S2d position{double(i % side), double(i / side % side)};
+        algae.emplace_back(position, 1);
+        scavengers.emplace_back(position, 1);
+        segments.emplace_back(position, 0.0, l_repro);
+    }
+
+    std::cout << entities << " of each record" << std::endl;
+    report_footprint("Algae", algae);
+    report_footprint("Scavenger", scavengers);
+    report_footprint("Segment", segments);
+    std::cout << "copy of all the records: "
+              << time_copy(algae, repeats) + time_copy(scavengers, repeats) +
+                     time_copy(segments, repeats)
+              << " ms" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int headless::benchmark_assignment(unsigned scavengers, unsigned corals) {
+    constexpr unsigned repeats(5);
+    const Simulation::Assignment modes[] = {Simulation::GREEDY, Simulation::GLOBAL};
+    const char* mode_names[] = {"greedy in order:   ", "global by distance:"};
+    std::cout << scavengers << " free scavengers, " << corals << " dead corals"
+              << std::endl;
+
+    for (int m = 0; m < 2; ++m) {
+        double update_ms(0), assignment_ms(0), distance(0);
+        for (unsigned r = 0; r < repeats; ++r) {
+            // the same random reef for both modes
+            Simulation simulation;
+            std::vector<S2d> seekers;
+            std::vector<S2d> bases;
+            make_assignment_reef(simulation, scavengers, corals, seekers, bases);
+            simulation.setAssignment(modes[m]);
+
+            auto start = std::chrono::steady_clock::now();
+            simulation.updateEntities();
+            update_ms += seconds_since(start) * 1000;
+            const stats::Registry& last = simulation.getLastTickStats();
+            assignment_ms += (last.phase_ns[stats::NEAREST_DEAD_CORAL] +
+                              last.phase_ns[stats::ASSIGN_TARGETS]) / 1e6;
+
+            // coral IDs are 1 to corals, in the order of bases
+            std::vector<int> matches;
+            for (const auto& scavenger : simulation.get_scavenger_in_simulation()) {
+                matches.push_back(scavenger.getTargetCoralId() - 1);
+            }
+            distance += assignment::total_distance(seekers, bases, matches);
+        }
+        std::cout << mode_names[m] << " update " << update_ms / repeats << " ms";
+        if (stats::enabled) {
+            std::cout << ", assignment " << assignment_ms / repeats << " ms";
+        }
+        std::cout << ", total distance " << distance / repeats << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
+
+int headless::benchmark_feeding(unsigned scavengers, unsigned long ticks) {
+    Simulation simulation;
+    make_feeding_reef(simulation, scavengers);
+    std::cout << scavengers << " scavengers eating " << scavengers << " dead corals"
+              << std::endl;
+
+    double update_ms(0), scavengers_ms(0);
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long tick = 0; tick < ticks; ++tick) {
+        auto tick_start = std::chrono::steady_clock::now();
+        simulation.updateEntities();
+        update_ms += seconds_since(tick_start) * 1000;
+        scavengers_ms +=
+            simulation.getLastTickStats().phase_ns[stats::UPDATE_SCAVENGERS] / 1e6;
+    }
+    double per_tick = ticks > 0 ? 1.0 / ticks : 0.0;
+    std::cout << ticks << " updates in " << seconds_since(start) << " s, "
+              << update_ms * per_tick << " ms per update";
+    if (stats::enabled) {
+        std::cout << " (scavengers " << scavengers_ms * per_tick << " ms)";
+    }
+    std::cout << "\nbirths per update: "
+              << (simulation.getScavengerCount() - scavengers) * per_tick << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int headless::export_frames(const std::string& config_file, unsigned long ticks,
+                            unsigned long every, const std::string& directory,
+                            unsigned threads, bool algae_birth) {
+    Simulation simulation;
+    if (!simulation.start(config_file)) {
+        return EXIT_FAILURE;
+    }
+    simulation.setAlgaeBirthAllowed(algae_birth);
+
+    auto start = std::chrono::steady_clock::now();
+    double render_seconds = 0;  // spent drawing on this thread (and on back pressure)
+    {
+        FrameExporter exporter(directory, threads);
+        for (unsigned long tick = 0; tick <= ticks; tick += every) {
+            if (tick > 0) {
+                simulation.runTicks(every);  // skips the idle updates
+            }
+            if (!exporter.getError().empty()) {
+                break;  // the frames would be dropped
+            }
+            auto render_start = std::chrono::steady_clock::now();
+            exporter.exportFrame(simulation);
+            render_seconds += seconds_since(render_start);
+        }
+        exporter.finish();
+        double total_seconds = seconds_since(start);
+        std::string error = exporter.getError();
+        if (!error.empty()) {
+            std::cerr << "Error: " << error << " (" << exporter.getFramesWritten()
+                      << " frames written)" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        unsigned long frames = exporter.getFramesWritten();
+        std::cout << frames << " frames written to " << directory << " by "
+                  << threads << " encoder thread(s)\n"
+                  << "total: " << total_seconds << " s, "
+                  << (total_seconds > 0 ? frames / total_seconds : 0) << " frames/s\n"
+                  << "simulation loop blocked " << render_seconds
+                  << " s for rendering" << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
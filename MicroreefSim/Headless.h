@@ -0,0 +1,104 @@
+/**
+ * File: Headless.h
+ * -----------------
+ * Description: Declares the command line modes of the program that run without
+ *              opening the window. They are selected by a first argument starting
+ *              with "--", any other invocation opens the GTK window as before.
+ *
+ *              Modes:
+ *              - --run <file> <ticks> [output]: runs ticks updates and saves the
+ *                final state in output if given, with --metrics <file.csv> every
+ *                update is sampled to a CSV file (MetricsRecorder.h) and with
+ *                --record <file.traj> the whole run is recorded (Trajectory.h)
+ *              - --replay <file.traj> <tick> [output]: seeks a recorded run to
+ *                tick and saves that state in output if given
+ *              - --digest <file> <ticks> [output]: the digest of the state after
+ *                each update (Digest.h), on the standard output if no output is
+ *                given; with --entities, also the digest of each entity
+ *              - --compare-digests <first> <second>: the first update where two
+ *                digest streams differ and what differs, fails if they do
+ *              - --golden <record|verify> <directory> [ticks]: runs every valid
+ *                t*.txt of directory (public/) with algae birth off and on and
+ *                records, or checks, the digests every 100 updates and a chain of
+ *                the digests of all the updates in directory/golden
+ *              - --bench-trajectory <file> [ticks]: size and time of recording
+ *                ticks updates against one saveSimulation per update
+ *              - --bench-timeline <file> [ticks] [megabytes]: the history of the
+ *                window (Timeline.h) within that budget, its time to record and
+ *                to seek back
+ *              - --bench-render <file> [frames] [ticks]: times one frame drawn on
+ *                an offscreen surface, one stroke per entity against one stroke
+ *                per style
+ *              - --bench-alloc <file> [ticks]: runs ticks updates with algae birth
+ *                on and reports the heap allocations per update (needs
+ *                MICROREEF_STATS) and how the segment pool served them
+ *              - --bench-assign [scavengers] [corals]: one update of a random
+ *                reef of free scavengers and dead corals in each assignment mode
+ *                (Simulation::Assignment), its time and the total distance
+ *                between the scavengers and the corals they were given
+ *              - --bench-feeding [scavengers] [ticks]: as many scavengers as dead
+ *                corals, all eating, one in seven dividing per update; time per
+ *                update and births
+ *              - --bench-fork <file> [branches] [ticks]: reading and validating
+ *                the file against forking the simulation read (Simulation::fork),
+ *                then runs the branches with algae birth on and seeds 1 to
+ *                branches; the branch of seed 1 must match a run of the file read
+ *                again
+ *              - --bench-footprint [entities]: fills vectors of algae, scavengers
+ *                and segments and reports their size against the same records
+ *                with a vptr, and the time to copy them
+ *              - --export-frames <file> <ticks> <every> <directory> [threads]:
+ *                runs ticks updates and writes every Nth one as a numbered PNG
+ *
+ *              Options accepted by every mode:
+ *              - --birth: algae birth is on while the simulation runs
+ *              - --trace <file.json>: records a Chrome trace of the run (Trace.h)
+ *              - --global-assign: with --run and --digest, the scavengers are
+ *                matched with the dead corals globally instead of greedily in order
+ *              - --counter-random: with --run and --digest, the random draws come
+ *                from the counter-based generator (Simulation::RandomMode)
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <string>
+
+namespace headless {
+// runs the mode named by argv[1] if there is one and stores its exit code in
+// status, returns false when the window should be opened instead
+bool run(int argc, char** argv, int& status);
+
+int run_ticks(const std::string& config_file, unsigned long ticks,
+              const std::string& output_file, const std::string& metrics_file,
+              const std::string& record_file, bool algae_birth,
+              bool global_assignment, bool counter_random);
+int replay(const std::string& trajectory_file, unsigned long tick,
+           const std::string& output_file);
+int write_digests(const std::string& config_file, unsigned long ticks,
+                  const std::string& output_file, bool entities, bool algae_birth,
+                  bool global_assignment, bool counter_random);
+int compare_digests(const std::string& first_file, const std::string& second_file);
+int golden(bool record, const std::string& directory, unsigned long ticks);
+int benchmark_trajectory(const std::string& config_file, unsigned long ticks,
+                         bool algae_birth);
+int benchmark_timeline(const std::string& config_file, unsigned long ticks,
+                       unsigned long megabytes, bool algae_birth);
+int benchmark_rendering(const std::string& config_file, unsigned frames,
+                        unsigned ticks);
+int benchmark_allocations(const std::string& config_file, unsigned long ticks);
+int benchmark_footprint(unsigned long entities);
+int benchmark_assignment(unsigned scavengers, unsigned corals);
+int benchmark_feeding(unsigned scavengers, unsigned long ticks);
+int benchmark_fork(const std::string& config_file, unsigned branches,
+                   unsigned long ticks);
+int export_frames(const std::string& config_file, unsigned long ticks,
+                  unsigned long every, const std::string& directory,
+                  unsigned threads, bool algae_birth);
+}  // namespace headless
+
+#endif  // HEADLESS_H
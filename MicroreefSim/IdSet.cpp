@@ -0,0 +1,126 @@
+/**
+ * File: IdSet.cpp
+ * ----------------
+ * Description: Implements the IdSet class from IdSet.h with linear probing.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "IdSet.h"
+
+#include <algorithm>
+
+namespace {
+constexpr size_t initial_slots(64);
+}  // namespace
+
+IdSet::IdSet()
+    : slots(initial_slots, empty_slot), count(0), has_empty_slot_ID(false) {}
+
+size_t IdSet::home(unsigned int ID) const {
+    // Fibonacci hashing, consecutive IDs land far apart
+    unsigned long long hash = ID * 0x9E3779B97F4A7C15ull;
+    return (hash >> 32) & (slots.size() - 1);
+}
+
+// slot holding ID, or the empty slot where it would go
+size_t IdSet::find_slot(unsigned int ID) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = home(ID);
+    while (slots[slot] != ID && slots[slot] != empty_slot) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+bool IdSet::insert(unsigned int ID) {
+    if (ID == empty_slot) {
+        bool inserted = !has_empty_slot_ID;
+        has_empty_slot_ID = true;
+        return inserted;
+    }
+    size_t slot = find_slot(ID);
+    if (slots[slot] == ID) {
+        return false;
+    }
+    slots[slot] = ID;
+    ++count;
+    if (2 * count > slots.size()) {
+        grow();
+    }
+    return true;
+}
+
+bool IdSet::erase(unsigned int ID) {
+    if (ID == empty_slot) {
+        bool erased = has_empty_slot_ID;
+        has_empty_slot_ID = false;
+        return erased;
+    }
+    size_t mask = slots.size() - 1;
+    size_t hole = find_slot(ID);
+    if (slots[hole] != ID) {
+        return false;
+    }
+    // move back the entries after the hole that could not use it when inserted
+    size_t next = (hole + 1) & mask;
+    while (slots[next] != empty_slot) {
+        size_t wanted = home(slots[next]);
+        if (((next - wanted) & mask) >= ((next - hole) & mask)) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    slots[hole] = empty_slot;
+    --count;
+    return true;
+}
+
+bool IdSet::contains(unsigned int ID) const {
+    if (ID == empty_slot) {
+        return has_empty_slot_ID;
+    }
+    return slots[find_slot(ID)] == ID;
+}
+
+void IdSet::clear() {
+    std::fill(slots.begin(), slots.end(), empty_slot);
+    count = 0;
+    has_empty_slot_ID = false;
+}
+
+size_t IdSet::size() const {
+    return count + (has_empty_slot_ID ? 1 : 0);
+}
+
+bool IdSet::empty() const {
+    return size() == 0;
+}
+
+std::vector<unsigned int> IdSet::sorted() const {
+    std::vector<unsigned int> IDs;
+    IDs.reserve(size());
+    for (unsigned int ID : slots) {
+        if (ID != empty_slot) {
+            IDs.push_back(ID);
+        }
+    }
+    if (has_empty_slot_ID) {
+        IDs.push_back(empty_slot);
+    }
+    std::sort(IDs.begin(), IDs.end());
+    return IDs;
+}
+
+void IdSet::grow() {
+    std::vector<unsigned int> old_slots(2 * slots.size(), empty_slot);
+    old_slots.swap(slots);
+    for (unsigned int ID : old_slots) {
+        if (ID != empty_slot) {
+            slots[find_slot(ID)] = ID;
+        }
+    }
+}
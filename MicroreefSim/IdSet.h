@@ -0,0 +1,50 @@
+/**
+ * File: IdSet.h
+ * --------------
+ * Description: Defines the IdSet class, a set of lifeform IDs stored in one flat
+ *              array with open addressing. It replaces std::set for the coral IDs
+ *              and the IDs targeted by the scavengers: those sets are looked up for
+ *              every scavenger on every update and a node based set allocated on
+ *              each insert and walked a tree on each lookup.
+ *
+ *              Insert, erase and lookup are O(1) on average and do not allocate,
+ *              the table only grows when it gets half full and clear keeps its
+ *              storage. Erase shifts the following entries back so there are no
+ *              tombstones and lookups stay short after many removals.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef IDSET_H
+#define IDSET_H
+
+#include <cstddef>
+#include <vector>
+
+class IdSet {
+public:
+    IdSet();
+
+    bool insert(unsigned int ID);  // false if the ID was already there
+    bool erase(unsigned int ID);   // false if the ID was not there
+    bool contains(unsigned int ID) const;
+    void clear();
+    size_t size() const;
+    bool empty() const;
+    std::vector<unsigned int> sorted() const;  // the IDs in increasing order
+
+private:
+    static constexpr unsigned int empty_slot = ~0u;  // the ID itself goes in a flag
+
+    std::vector<unsigned int> slots;  // size is a power of two
+    size_t count;                     // IDs in slots, not counting empty_slot
+    bool has_empty_slot_ID;
+
+    size_t home(unsigned int ID) const;  // first slot to try for ID
+    size_t find_slot(unsigned int ID) const;
+    void grow();
+};
+
+#endif  // IDSET_H
@@ -3,8 +3,8 @@
  * File: Lifeform.cpp
  * ------------------
  * Description: Implements the Lifeform class defined in Lifeform.h. This source file
- * provides detailed implementations of the constructors, destructor, and member
- * functions for handling the life form's state, such as age and position.
+ * provides detailed implementations of the constructor and member functions for
+ * handling the life form's state, such as age and position.
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -13,50 +13,37 @@
 
 #include "Lifeform.h"
 
-unsigned int Lifeform::nbLifeforms = 0;
-
 //-------------------Lifeform-------------------
 Lifeform::Lifeform(const S2d& position, unsigned int initialAge)
-    : pos(position), age(initialAge) {
+    : pos(position), birth(-static_cast<long long>(initialAge)) {
     /* if (age <= 0) {
         std::cout << message::lifeform_age(age);
         std::exit(EXIT_FAILURE);  // redue 2
     } */
-
-    ++nbLifeforms;
 }
 
-// Copy constructor implementation
-Lifeform::Lifeform(const Lifeform& other) : pos(other.pos), age(other.age) {}
-
-// Destructor implementation
-Lifeform::~Lifeform() {
-    --nbLifeforms;
+bool Lifeform::operator==(const Lifeform& other) const {
+    return (pos == other.pos) && (birth == other.birth);
 }
 
-// Assignment operator implementation
-Lifeform& Lifeform::operator=(const Lifeform& other) {
-    if (this != &other) {
-        pos = other.pos;
-        age = other.age;
-    }
-    return *this;
+bool Lifeform::operator!=(const Lifeform& other) const {
+    return !(*this == other);
 }
 
-bool Lifeform::operator==(const Lifeform& other) const {
-    return (pos == other.pos) && (age == other.age);
+unsigned int Lifeform::getAge(unsigned long now) const {
+    return static_cast<unsigned int>(static_cast<long long>(now) - birth);
 }
 
-bool Lifeform::operator!=(const Lifeform& other) const {
-    return !(*this == other);
+void Lifeform::setAge(unsigned int newAge, unsigned long now) {
+    birth = static_cast<long long>(now) - newAge;
 }
 
-unsigned int Lifeform::getAge() const {
-    return age;
+long long Lifeform::getBirthTick() const {
+    return birth;
 }
 
-void Lifeform::incrementAge() {
-    ++age;
+void Lifeform::setBirthTick(long long tick) {
+    birth = tick;
 }
 
 S2d Lifeform::getPosition() const {
@@ -67,7 +54,6 @@ void Lifeform::setPosition(const S2d& newPosition) {
     pos = newPosition;
 }
 
-std::ostream& operator<<(std::ostream& os, const Lifeform& lifeform) {
-    os << lifeform.pos.x << " " << lifeform.pos.y << " " << lifeform.age;
-    return os;
+void Lifeform::write(std::ostream& os, unsigned long now) const {
+    os << pos.x << " " << pos.y << " " << getAge(now);
 }
\ No newline at end of file
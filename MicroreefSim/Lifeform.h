@@ -14,23 +14,28 @@
 #ifndef LIFEFORM_H
 #define LIFEFORM_H
 
+#include <type_traits>
 #include <vector>
 
 #include "shape.h"
 
 class Lifeform {
 public:
+    // no virtual destructor and implicit copies: the entities are plain values,
+    // never deleted through a base pointer
     Lifeform(const S2d& position, unsigned int initialAge = 1);
-    Lifeform(const Lifeform& other);  // Copy constructor
-    virtual ~Lifeform();
-    friend std::ostream& operator<<(std::ostream& os, const Lifeform& lifeform);
+    // writes "x y age" with the age at tick now
+    void write(std::ostream& os, unsigned long now) const;
 
-    Lifeform& operator=(const Lifeform& other);  // Assignment operator
     bool operator==(const Lifeform& other) const;
     bool operator!=(const Lifeform& other) const;
 
-    unsigned int getAge() const;
-    void incrementAge();
+    // the age is not stored but derived from the birth tick, so nothing has to be
+    // updated when time passes
+    unsigned int getAge(unsigned long now) const;  // age at tick now
+    void setAge(unsigned int newAge, unsigned long now);
+    long long getBirthTick() const;
+    void setBirthTick(long long tick);  // to rebuild an entity recorded earlier
     // virtual void Update()=0;//purement virtuelle
     S2d getPosition() const;
     void setPosition(const S2d& newPosition);
@@ -40,10 +45,9 @@ public:
 
 protected:
     S2d pos;
-    unsigned int age;
-    static unsigned int nbLifeforms;
+    long long birth;  // tick at which the age was 0, negative when read from a file
 };
 
-std::ostream& operator<<(std::ostream& os, const Lifeform& lifeform);
+static_assert(std::is_trivially_copyable_v<Lifeform>);
 
 #endif  // LIFEFORM_H
@@ -0,0 +1,151 @@
+/**
+ * File: MetricsRecorder.cpp
+ * --------------------------
+ * Description: Implements the MetricsRecorder class from MetricsRecorder.h.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "MetricsRecorder.h"
+
+#include <unistd.h>  // for sysconf
+
+#include <algorithm>
+
+MetricsRecorder::MetricsRecorder(size_t capacity_)
+    : capacity(std::max<size_t>(capacity_, 2)), recorded(0), written(0), memory_kb(0) {
+    for (auto& column : columns) {
+        column.assign(capacity, 0.0);
+    }
+}
+
+MetricsRecorder::~MetricsRecorder() {
+    close();
+}
+
+bool MetricsRecorder::open(const std::string& filename) {
+    close();
+    file.open(filename);
+    if (!file) {
+        return false;
+    }
+    file << column_name(Column(0));
+    for (int c = 1; c < COLUMN_COUNT; ++c) {
+        file << ',' << column_name(Column(c));
+    }
+    file << '\n';
+    written = recorded;  // only what comes from now on
+    return true;
+}
+
+void MetricsRecorder::close() {
+    if (file.is_open()) {
+        flush();
+        file.close();
+    }
+}
+
+bool MetricsRecorder::isOpen() const {
+    return file.is_open();
+}
+
+void MetricsRecorder::record(const Simulation& simulation, unsigned long tick,
+                             double tick_ms) {
+    if (file.is_open() && recorded - written >= capacity / 2) {
+        flush();
+    }
+    if (recorded % memory_sample_period == 0) {
+        memory_kb = resident_memory_kb();
+    }
+
+    unsigned live_corals(0), dead_corals(0), segments(0);
+    for (const auto& coral : simulation.get_coral_in_simulation()) {
+        if (coral.getStatut() == ALIVE) {
+            ++live_corals;
+        } else {
+            ++dead_corals;
+        }
+        segments += coral.getSegmentCount();
+    }
+
+    size_t row = recorded % capacity;
+    columns[TICK][row] = tick;
+    columns[ALGAE][row] = simulation.getAlgaeCount();
+    columns[LIVE_CORALS][row] = live_corals;
+    columns[DEAD_CORALS][row] = dead_corals;
+    columns[SCAVENGERS][row] = simulation.getScavengerCount();
+    columns[SEGMENTS][row] = segments;
+    columns[TICK_MS][row] = tick_ms;
+    columns[MEMORY_KB][row] = memory_kb;
+    ++recorded;
+}
+
+void MetricsRecorder::flush() {
+    if (!file.is_open()) {
+        return;
+    }
+    written = std::max(written, recorded - size());  // rows already overwritten
+    for (; written < recorded; ++written) {
+        size_t row = written % capacity;
+        file << static_cast<unsigned long>(columns[TICK][row]);
+        for (int c = 1; c < COLUMN_COUNT; ++c) {
+            file << ',' << columns[c][row];
+        }
+        file << '\n';
+    }
+    file.flush();
+}
+
+void MetricsRecorder::clear() {
+    flush();
+    recorded = 0;
+    written = 0;
+}
+
+size_t MetricsRecorder::size() const {
+    return std::min<unsigned long long>(recorded, capacity);
+}
+
+void MetricsRecorder::recent(Column column, size_t count,
+                             std::vector<double>& values) const {
+    count = std::min(count, size());
+    values.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = columns[column][(recorded - count + i) % capacity];
+    }
+}
+
+const char* MetricsRecorder::column_name(Column column) {
+    switch (column) {
+        case TICK:
+            return "tick";
+        case ALGAE:
+            return "algae";
+        case LIVE_CORALS:
+            return "live_corals";
+        case DEAD_CORALS:
+            return "dead_corals";
+        case SCAVENGERS:
+            return "scavengers";
+        case SEGMENTS:
+            return "segments";
+        case TICK_MS:
+            return "tick_ms";
+        case MEMORY_KB:
+            return "memory_kb";
+        default:
+            return "?";
+    }
+}
+
+double MetricsRecorder::resident_memory_kb() {
+    // second field of /proc/self/statm: resident pages (Linux only, 0 elsewhere)
+    std::ifstream statm("/proc/self/statm");
+    unsigned long total_pages(0), resident_pages(0);
+    if (!(statm >> total_pages >> resident_pages)) {
+        return 0;
+    }
+    return resident_pages * (sysconf(_SC_PAGESIZE) / 1024.0);
+}
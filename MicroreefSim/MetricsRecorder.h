@@ -0,0 +1,74 @@
+/**
+ * File: MetricsRecorder.h
+ * ------------------------
+ * Description: Defines the MetricsRecorder class, which keeps a time series of the
+ *              population and of the cost of each update: algae, live and dead
+ *              corals, scavengers, total coral segments, duration of the update
+ *              and resident memory of the process.
+ *
+ *              The samples are stored column by column in buffers allocated once,
+ *              used as rings: memory stays bounded however long the run is and the
+ *              most recent samples are always there for the sparklines. When a CSV
+ *              file is open the rows are appended to it every half buffer, before
+ *              they can be overwritten.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef METRICS_RECORDER_H
+#define METRICS_RECORDER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Simulation.h"
+
+class MetricsRecorder {
+public:
+    enum Column {
+        TICK,
+        ALGAE,
+        LIVE_CORALS,
+        DEAD_CORALS,
+        SCAVENGERS,
+        SEGMENTS,
+        TICK_MS,    // duration of the update
+        MEMORY_KB,  // resident memory, read every memory_sample_period samples
+        COLUMN_COUNT
+    };
+
+    explicit MetricsRecorder(size_t capacity_ = 4096);
+    ~MetricsRecorder();  // writes the rows not written yet
+
+    // starts writing the rows to filename (CSV with a header), returns false if
+    // the file could not be opened
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const;
+
+    void record(const Simulation& simulation, unsigned long tick, double tick_ms);
+    void flush();  // writes the rows not written yet if a file is open
+    void clear();  // forgets the samples, e.g. when another file is loaded
+
+    size_t size() const;  // samples held, at most the capacity
+    // the last count values of column (fewer if not recorded yet), oldest first
+    void recent(Column column, size_t count, std::vector<double>& values) const;
+
+    static const char* column_name(Column column);
+
+private:
+    size_t capacity;
+    std::vector<double> columns[COLUMN_COUNT];
+    unsigned long long recorded;  // samples since the start, the ring index is modulo
+    unsigned long long written;   // samples already in the file
+    double memory_kb;             // last memory reading
+    std::ofstream file;
+
+    static constexpr unsigned memory_sample_period = 64;
+    static double resident_memory_kb();
+};
+
+#endif  // METRICS_RECORDER_H
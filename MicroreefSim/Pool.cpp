@@ -0,0 +1,229 @@
+/**
+ * File: Pool.cpp
+ * ---------------
+ * Description: Implements the small-block pool declared in Pool.h.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "Pool.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace {
+constexpr unsigned smallest_class(6);  // 64 bytes
+constexpr unsigned largest_class(16);  // 64 KiB
+constexpr size_t chunk_size(size_t(1) << 18);
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+void push(FreeBlock*& list, void* block) {
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = list;
+    list = freed;
+}
+
+struct Chunk {
+    char* next = nullptr;  // unused part of the chunk
+    char* end = nullptr;
+
+    size_t left() const { return size_t(end - next); }
+};
+
+struct ThreadPool {
+    FreeBlock* free_lists[largest_class + 1] = {};
+    Chunk chunk;
+    pool::Counters counters = {};
+    // the blocks went to the orphans, later allocations and frees use them
+    bool ended = false;
+
+    ~ThreadPool();  // at the end of the thread
+};
+
+// the blocks of the threads that ended, until another thread takes them
+struct Orphans {
+    std::mutex mutex;
+    FreeBlock* free_lists[largest_class + 1] = {};
+    Chunk chunk;  // the biggest chunk rest handed over
+    // bit of each class with blocks, and chunk_bit, read unlocked
+    std::atomic<unsigned> filled{0};
+};
+constexpr unsigned chunk_bit(1);  // below the smallest class
+
+Orphans orphans;
+thread_local ThreadPool thread_pool;
+
+// cuts the rest of chunk into blocks, the biggest first; the sizes are multiples
+// of the smallest block so nothing is left
+void free_chunk_rest(Chunk& chunk, FreeBlock** lists) {
+    for (unsigned block_class = largest_class; block_class >= smallest_class;
+         --block_class) {
+        size_t block_size = size_t(1) << block_class;
+        while (chunk.left() >= block_size) {
+            push(lists[block_class], chunk.next);
+            chunk.next += block_size;
+        }
+    }
+}
+
+// a block_size block cut from chunk; when it cannot hold it, what is left of it,
+// less than this block but possibly almost as big as the biggest one, goes to
+// lists (the smaller classes) and the block comes from fresh, a new chunk unless
+// one is given
+void* carve(Chunk& chunk, FreeBlock** lists, size_t block_size,
+            pool::Counters& counters, Chunk fresh = {}) {
+    if (chunk.left() < block_size) {
+        free_chunk_rest(chunk, lists);
+        if (fresh.left() >= block_size) {
+            chunk = fresh;
+        } else {
+            chunk.next = static_cast<char*>(::operator new(chunk_size));
+            chunk.end = chunk.next + chunk_size;
+            ++counters.chunks;
+        }
+    }
+    void* block = chunk.next;
+    chunk.next += block_size;
+    ++counters.carved;
+    return block;
+}
+
+// the caller holds orphans.mutex
+void update_filled() {
+    unsigned filled(orphans.chunk.left() > 0 ? chunk_bit : 0);
+    for (unsigned block_class = smallest_class; block_class <= largest_class;
+         ++block_class) {
+        if (orphans.free_lists[block_class]) {
+            filled |= 1u << block_class;
+        }
+    }
+    orphans.filled = filled;
+}
+
+ThreadPool::~ThreadPool() {
+    std::lock_guard<std::mutex> lock(orphans.mutex);
+    for (unsigned block_class = smallest_class; block_class <= largest_class;
+         ++block_class) {
+        while (FreeBlock* block = free_lists[block_class]) {
+            free_lists[block_class] = block->next;
+            push(orphans.free_lists[block_class], block);
+        }
+    }
+    // the bigger rest is kept whole to carve from, the smaller one cut in blocks
+    if (chunk.left() > orphans.chunk.left()) {
+        std::swap(chunk, orphans.chunk);
+    }
+    free_chunk_rest(chunk, orphans.free_lists);
+    update_filled();
+    ended = true;
+}
+
+// moves the orphan blocks of block_class to the free list of this thread
+void adopt(unsigned block_class) {
+    if (!(orphans.filled.load(std::memory_order_relaxed) & (1u << block_class))) {
+        return;  // nothing to take, no lock
+    }
+    std::lock_guard<std::mutex> lock(orphans.mutex);
+    thread_pool.free_lists[block_class] = orphans.free_lists[block_class];
+    orphans.free_lists[block_class] = nullptr;
+    update_filled();
+}
+
+// the chunk rest of the orphans, if there is one, for a thread out of chunk
+Chunk adopt_chunk() {
+    if (!(orphans.filled.load(std::memory_order_relaxed) & chunk_bit)) {
+        return {};
+    }
+    std::lock_guard<std::mutex> lock(orphans.mutex);
+    Chunk chunk = orphans.chunk;
+    orphans.chunk = {};
+    update_filled();
+    return chunk;
+}
+
+// for a thread whose pool ended, e.g. from the destructor of another thread_local:
+// the block comes from the orphans, carved from their chunk if none is free
+void* allocate_orphan(unsigned block_class) {
+    std::lock_guard<std::mutex> lock(orphans.mutex);
+    void* block = orphans.free_lists[block_class];
+    if (block) {
+        orphans.free_lists[block_class] = orphans.free_lists[block_class]->next;
+        ++thread_pool.counters.reused;
+    } else {
+        block = carve(orphans.chunk, orphans.free_lists, size_t(1) << block_class,
+                      thread_pool.counters);
+    }
+    update_filled();
+    return block;
+}
+
+// smallest class whose blocks hold bytes
+unsigned size_class(size_t bytes) {
+    unsigned size_class(smallest_class);
+    while ((size_t(1) << size_class) < bytes) {
+        ++size_class;
+    }
+    return size_class;
+}
+}  // namespace
+
+void* pool::allocate(size_t bytes) {
+    if (bytes > (size_t(1) << largest_class)) {
+        ++thread_pool.counters.oversized;
+        return ::operator new(bytes);
+    }
+    unsigned block_class = size_class(bytes);
+    size_t block_size = size_t(1) << block_class;
+
+    if (thread_pool.ended) {
+        return allocate_orphan(block_class);
+    }
+    if (!thread_pool.free_lists[block_class]) {
+        adopt(block_class);
+    }
+    if (FreeBlock* block = thread_pool.free_lists[block_class]) {
+        thread_pool.free_lists[block_class] = block->next;
+        ++thread_pool.counters.reused;
+        return block;
+    }
+    Chunk fresh;
+    if (thread_pool.chunk.left() < block_size) {
+        fresh = adopt_chunk();  // given back to the orphans if too small
+        if (fresh.left() > 0 && fresh.left() < block_size) {
+            std::lock_guard<std::mutex> lock(orphans.mutex);
+            free_chunk_rest(fresh, orphans.free_lists);
+            update_filled();
+        }
+    }
+    return carve(thread_pool.chunk, thread_pool.free_lists, block_size,
+                 thread_pool.counters, fresh);
+}
+
+void pool::deallocate(void* block, size_t bytes) noexcept {
+    if (!block) {
+        return;
+    }
+    if (bytes > (size_t(1) << largest_class)) {
+        ::operator delete(block);
+        return;
+    }
+    unsigned block_class = size_class(bytes);
+    if (thread_pool.ended) {  // freed by a destructor after the end of the thread
+        std::lock_guard<std::mutex> lock(orphans.mutex);
+        push(orphans.free_lists[block_class], block);
+        orphans.filled |= 1u << block_class;
+        return;
+    }
+    push(thread_pool.free_lists[block_class], block);
+}
+
+const pool::Counters& pool::counters() {
+    return thread_pool.counters;
+}
@@ -0,0 +1,77 @@
+/**
+ * File: Pool.h
+ * -------------
+ * Description: Small-block pool used for the segment vectors of the corals. Every
+ *              update copies, grows and shrinks these vectors, and going through
+ *              malloc each time was a large part of the cost of updateCorals.
+ *
+ *              Blocks are rounded up to a power of two (64 bytes to 64 KiB) and
+ *              carved from 256 KiB chunks, shared by all the classes; when a chunk
+ *              cannot hold the next block, what is left of it is cut into blocks
+ *              of the smaller classes. A freed block goes on the free list of its
+ *              size class and is reused by the next allocation of that class, so
+ *              in a steady state the pool does not allocate at all. Bigger
+ *              requests go to operator new.
+ *
+ *              The free lists belong to the calling thread, so no lock is needed.
+ *              A block may be freed by another thread than the one that allocated
+ *              it, it then joins the free lists of that thread: to allow this the
+ *              chunks are never given back, the pool keeps its peak size. When a
+ *              thread ends (the file loader, the saver and the frame encoders live
+ *              for one job), its free blocks and the rest of its chunk go to a
+ *              shared list under a lock, which the other threads take from before
+ *              they carve a new chunk; the biggest chunk rest is kept whole there.
+ *              What the ended thread still allocates or frees, from the
+ *              destructors that run after, uses that list and that chunk too.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <cstddef>
+
+namespace pool {
+void* allocate(size_t bytes);
+void deallocate(void* block, size_t bytes) noexcept;
+
+struct Counters {  // for the calling thread, since it started
+    unsigned long long chunks;     // chunks taken from operator new
+    unsigned long long carved;     // blocks cut from a chunk
+    unsigned long long reused;     // blocks taken from a free list
+    unsigned long long oversized;  // requests sent to operator new
+};
+const Counters& counters();
+
+// standard allocator on top of the pool, for std::vector and friends
+template <class T>
+struct Allocator {
+    using value_type = T;
+
+    Allocator() noexcept = default;
+    template <class U>
+    Allocator(const Allocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(pool::allocate(count * sizeof(T)));
+    }
+    void deallocate(T* block, size_t count) noexcept {
+        pool::deallocate(block, count * sizeof(T));
+    }
+};
+
+// all pool allocators can free each other's blocks
+template <class T, class U>
+bool operator==(const Allocator<T>&, const Allocator<U>&) noexcept {
+    return true;
+}
+template <class T, class U>
+bool operator!=(const Allocator<T>&, const Allocator<U>&) noexcept {
+    return false;
+}
+}  // namespace pool
+
+#endif  // POOL_H
@@ -5,8 +5,7 @@
  * derivative of the CircularLifeform class. Scavengers are circular life forms that
  * interact with coral within the simulation. This class introduces additional
  * behaviors such as moving towards, consuming coral, and reproducing. It manages
- * scavenger-specific properties like status and target coral ID, along with a static
- * count of Scavenger instances to track their population.
+ * scavenger-specific properties like status and target coral ID.
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -17,7 +16,7 @@
 #define SCAVENGER_H
 
 #include "CircularLifeform.h"
-#include <set>
+#include "Handle.h"
 
 class Scavenger : public CircularLifeform {
 public:
@@ -25,43 +24,36 @@ public:
     Scavenger(const S2d& position, unsigned int initialAge, double radius = r_sca,
               Statut_sca status = LIBRE, int targetCoralId_ = -1);
 
-    Scavenger(const Scavenger& other);
-    Scavenger& operator=(const Scavenger& other);
     bool operator==(const Scavenger& other) const;
     bool operator!=(const Scavenger& other) const;
 
-    virtual ~Scavenger();
     // void update();
 
     Statut_sca getStatus() const;
     void setStatus(Statut_sca newStatus);
     int getTargetCoralId() const;
-    static int getNbScavengers();
-    static void incrementNbScavengers();
-    static void decrementNbScavengers();
+    // a new ID forgets the handle of the old target, set_targetCoral gives the new
+    // one; the ID is what is saved, the handle what the Simulation looks up
     void set_targetCoralId(unsigned int newtargetCoralId);
+    Handle get_targetCoral() const;
+    void set_targetCoral(Handle coral);
 
-    friend std::ostream& operator<<(std::ostream& os, const Scavenger& scavenger);
+    // the target is only written while the scavenger is eating
+    void write(std::ostream& os, unsigned long now) const;
 
     void move(const S2d& newPosition);
 
-    static void clear_targetIDs();
-    static void addTargetID(unsigned int targetID);
-    static void removeTargetID(unsigned int targetID);
-    static std::set<unsigned int> getTargetIDs();
-
-    static void printTargetIDs() ;
-
     void increse_radius(double delta);
 
 
 private:
     Statut_sca status;
     unsigned int targetCoralId;
-    static int nbsca;
-    static std::set<unsigned int> targetIDs; 
+    Handle targetCoral;  // handle of the coral in the Simulation
 };
 
-std::ostream& operator<<(std::ostream& os, const Scavenger& scavenger);
+static_assert(std::is_trivially_copyable_v<Scavenger>);
+static_assert(sizeof(Scavenger) ==
+              sizeof(CircularLifeform) + 2 * sizeof(unsigned) + sizeof(Handle));
 
 #endif
@@ -2,9 +2,9 @@
  * File: SegmentLifeform.cpp
  * --------------------------
  * Description: Implements the SegmentLifeform class from SegmentLifeform.h. This
- * source file provides detailed implementations of constructors, destructors, and
- * methods to manage the vector of Segments. These functionalities extend the basic
- * Lifeform features, integrating operations that are specific to segmented life forms,
+ * source file provides detailed implementations of the constructor and methods to
+ * manage the vector of Segments. These functionalities extend the basic Lifeform
+ * features, integrating operations that are specific to segmented life forms,
  *              such as equality checks that consider both positional and
  * segment-specific characteristics.
  *
@@ -15,25 +15,11 @@
 
 #include "SegmentLifeform.h"
 
-SegmentLifeform::SegmentLifeform(const S2d& base_, unsigned int initialAge,
-                                 std::vector<Segment> segments_)
-    : Lifeform(base_, initialAge), segments(segments_) {}
-
-// Copy constructor implementation
-SegmentLifeform::SegmentLifeform(const SegmentLifeform& other)
-    : Lifeform(other), segments(other.segments) {}
-
-// Assignment operator implementation
-SegmentLifeform& SegmentLifeform::operator=(const SegmentLifeform& other) {
-    if (this != &other) {
-        Lifeform::operator=(other);
-        segments = other.segments;
-    }
-    return *this;
-}
+#include <utility>  // for std::move
 
-// Destructor implementation
-SegmentLifeform::~SegmentLifeform() {}
+SegmentLifeform::SegmentLifeform(const S2d& base_, unsigned int initialAge,
+                                 SegmentVector segments_)
+    : Lifeform(base_, initialAge), segments(std::move(segments_)) {}
 
 bool SegmentLifeform::areSegmentsInside() const {
     for (const auto& segment : segments) {
@@ -63,10 +49,14 @@ bool SegmentLifeform::operator!=(const SegmentLifeform& other) const {
     return !(*this == other);
 }
 
-std::vector<Segment> SegmentLifeform::getSegments() const {
+const SegmentVector& SegmentLifeform::getSegments() const {
     return segments;
 }
 
+size_t SegmentLifeform::getSegmentCount() const {
+    return segments.size();
+}
+
 std::ostream& operator<<(std::ostream& os, const SegmentLifeform& other) {
     // os << static_cast<const Lifeform&>(other) << ", Segment(s): ";
     //  for each segment say its number and (segment 0 segment  1) then the segment
@@ -17,24 +17,26 @@
 #define SEGMENTLIFEFORM_H
 
 #include "Lifeform.h"
+#include "Pool.h"
 #include "constantes.h"
 
+// the segments of a coral change every update, they are kept in the pool (Pool.h)
+using SegmentVector = std::vector<Segment, pool::Allocator<Segment>>;
+
 class SegmentLifeform : public Lifeform {
 public:
     SegmentLifeform(const S2d& base_, unsigned int initialAge,
-                    std::vector<Segment> segments_);
+                    SegmentVector segments_);
 
-    SegmentLifeform(const SegmentLifeform& other);             // Copy constructor
-    SegmentLifeform& operator=(const SegmentLifeform& other);  // Assignment operator
     bool operator==(const SegmentLifeform& other) const;
     bool operator!=(const SegmentLifeform& other) const;
-    virtual ~SegmentLifeform();
     bool areSegmentsInside() const;
-    std::vector<Segment> getSegments() const;
+    const SegmentVector& getSegments() const;
+    size_t getSegmentCount() const;
     friend std::ostream& operator<<(std::ostream& os, const SegmentLifeform& lifeform);
 
 protected:
-    std::vector<Segment> segments;
+    SegmentVector segments;
 };
 
 std::ostream& operator<<(std::ostream& os, const SegmentLifeform& lifeform);
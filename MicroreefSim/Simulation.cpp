@@ -16,31 +16,133 @@
 
 #include "Simulation.h"
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>  // for std::make_move_iterator
+#include <sstream>
 #include <stdexcept>
+#include <unordered_map>
+#include <utility>   // for std::move
+
+#include "Assignment.h"
+#include "Trace.h"
+
+namespace {
+// erases the entities for which dead is true and the holes left by
+// HandleTable::remove in one pass, the others keep their order and their handles
+template <class Entity, class Predicate>
+void erase_entities_if(std::vector<Entity>& entities, HandleTable& handles,
+                       Predicate dead) {
+    size_t kept(0);
+    bool holes = handles.firstRemoved() < entities.size();
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (holes && handles.isRemoved(i)) {
+            continue;
+        }
+        if (dead(entities[i])) {
+            handles.release(i);
+            continue;
+        }
+        if (kept != i) {
+            entities[kept] = std::move(entities[i]);
+            handles.move(i, kept);
+        }
+        ++kept;
+    }
+    entities.erase(entities.begin() + kept, entities.end());
+    handles.truncate(kept);
+}
 
-bool Simulation::readFileSuccess = true;
-bool Simulation::algae_birth_allowed = false;
+// closes the holes left by HandleTable::remove, from the first one on: one pass
+// for all the removals of a phase instead of one shift of the vector each
+template <class Entity>
+void compact_entities(std::vector<Entity>& entities, HandleTable& handles) {
+    size_t kept = handles.firstRemoved();
+    if (kept == entities.size()) {
+        return;
+    }
+    for (size_t i = kept + 1; i < entities.size(); ++i) {
+        if (!handles.isRemoved(i)) {
+            entities[kept] = std::move(entities[i]);
+            handles.move(i, kept);
+            ++kept;
+        }
+    }
+    entities.erase(entities.begin() + kept, entities.end());
+    handles.truncate(kept);
+}
 
-Simulation::Simulation()
-    : algaeCreationDistribution(alg_birth_rate), positionDistribution(1, max - 1) {
-    e.seed(1);  // This seeds the random number generator
+// position of entity in entities: O(1) when it is an element of the vector,
+// otherwise the first equal one; entities.size() if there is none
+template <class Entity>
+size_t position_of(const std::vector<Entity>& entities, const Entity& entity) {
+    const Entity* data = entities.data();
+    if (&entity >= data && &entity < data + entities.size()) {
+        return &entity - data;
+    }
+    return std::find(entities.begin(), entities.end(), entity) - entities.begin();
 }
+}  // namespace
 
-void Simulation::start(const std::string& config_file) {
+Simulation::Simulation()
+    : next_coral_ID(1),
+      readFileSuccess(true),
+      read_progress(nullptr),
+      read_size(0),
+      entries_read(0),
+      read_stopped(false),
+      static_revision(0),
+      assignment_mode(GREEDY),
+      random_mode(ENGINE),
+      last_tick_stats{},
+      tick(0),
+      death_wheel(std::max({max_life_alg, max_life_cor, max_life_sca}) + 1,
+                  DueDeaths{{}, 0, 0}),
+      algae_birth_allowed(false),
+      random_seed(1),
+      counter_random(random_seed),
+      algaeCreationDistribution(alg_birth_rate),
+      positionDistribution(1, max - 1) {
+    e.seed(random_seed);  // This seeds the random number generator
+}
+
+bool Simulation::start(const std::string& config_file,
+                       const ReadProgress& progress) {
     reset_simulation();
-    readConfigFile(config_file);
+    read_progress = progress ? &progress : nullptr;
+    bool read = readConfigFile(config_file);
+    read_progress = nullptr;
+    return read;
     // std::cout << "INITIAL STATE" << std::endl;
     // print_algae_vector_with_age();
 }
-void Simulation::readConfigFile(const std::string& filename) {
+
+void Simulation::replaceWith(Simulation&& loaded) {
+    unsigned long revision = std::max(static_revision, loaded.static_revision);
+    *this = std::move(loaded);
+    static_revision = revision + 1;  // the view may have drawn either of them
+}
+
+Simulation Simulation::fork() const {
+    TRACE_SCOPE("fork");
+    // every member is a value and the handles are indices into tables copied
+    // along, so the scavengers of the copy target the corals of the copy
+    return *this;
+}
+
+bool Simulation::readConfigFile(const std::string& filename) {
+    TRACE_SCOPE("readConfigFile");
     clearAllEntities();             // clear all entities before reading the file
     resetRandomEngineForNewFile();  // Reset the random engine for reproducibility
-    std::ifstream file(filename);
+    std::ifstream file(filename, std::ios::ate);
     if (!file.is_open()) {
         reportError("Cannot open configuration file.");
-        return;
+        return false;
     }
+    read_size = file.tellg();
+    file.seekg(0);
+    entries_read = 0;
+    read_stopped = false;
     // Skip comments and empty lines
     std::string line;
     while (std::getline(file, line)) {
@@ -67,10 +169,31 @@ void Simulation::readConfigFile(const std::string& filename) {
     if (!readFileSuccess) {
         clearAllEntities();
         file.close();
-        return;
+        return !read_stopped;
     }
     file.close();
     std::cout << message::success();
+    return true;
+}
+
+bool Simulation::continue_reading(std::ifstream& file) {
+    if (read_stopped) {
+        return false;
+    }
+    // every few entries only, tellg is not free
+    if (!read_progress || ++entries_read % 64 != 0) {
+        return true;
+    }
+    double fraction = 1.0;
+    std::streamoff position = file.tellg();
+    if (position >= 0 && read_size > 0) {
+        fraction = std::min(1.0, double(position) / read_size);
+    }
+    if (!(*read_progress)(fraction)) {
+        read_stopped = true;
+        readFileSuccess = false;  // what was read is cleared
+    }
+    return !read_stopped;
 }
 
 void Simulation::handleFileReadError(std::ifstream& file, int entryIndex,
@@ -87,7 +210,7 @@ void Simulation::handleFileReadError(std::ifstream& file, int entryIndex,
 
 void Simulation::readAlgae(std::ifstream& file, int count) {
     // std::cout << "Reading " << count << " algae entries." << std::endl;
-    for (int i = 0; i < count; ++i) {
+    for (int i = 0; i < count && continue_reading(file); ++i) {
         double x, y;
         unsigned int age;
         file >> x >> y >> age;
@@ -100,7 +223,7 @@ void Simulation::readAlgae(std::ifstream& file, int count) {
 
         Algae algae(S2d{x, y}, age);
         if (validateAlgae(algae)) {
-            algaeVec.push_back(algae);
+            add_Algae_To_Simulation(algae);
         } else {
             // std::cout << "Invalid algae data at entry " << i << std::endl;
         }
@@ -109,9 +232,9 @@ void Simulation::readAlgae(std::ifstream& file, int count) {
     //  << std::endl;
 }
 //-------------------validateAlgae-------------------
-bool Simulation::validateAlgae(const Algae& algae) const {
-    if (algae.getAge() <= 0) {
-        std::cout << message::lifeform_age(algae.getAge());
+bool Simulation::validateAlgae(const Algae& algae) {
+    if (algae.getAge(tick) <= 0) {
+        std::cout << message::lifeform_age(algae.getAge(tick));
         // std::exit(EXIT_FAILURE);  // redue 2
         readFileSuccess = false;
         return false;
@@ -131,7 +254,7 @@ bool Simulation::validateAlgae(const Algae& algae) const {
 
 //-------------------readCoral-------------------
 void Simulation::readCoral(std::ifstream& file, int count) {
-    for (int i = 0; i < count; ++i) {
+    for (int i = 0; i < count && continue_reading(file); ++i) {
         double x, y, firstAngle, firstLength;
         unsigned int age, id, nbseg;
         int statut_int, dir_rot_int, statut_dev_int;
@@ -164,7 +287,7 @@ void Simulation::readCoral(std::ifstream& file, int count) {
             coral.addSegment(angle, length);
         }
         if (validateCoral(coral)) {
-            coralVec.push_back(coral);
+            add_Coral_To_Simulation(std::move(coral));
         } else {
         }
     }
@@ -172,7 +295,7 @@ void Simulation::readCoral(std::ifstream& file, int count) {
 
 //-------------------readScavenger-------------------
 void Simulation::readScavenger(std::ifstream& file, int count) {
-    for (int i = 0; i < count; ++i) {
+    for (int i = 0; i < count && continue_reading(file); ++i) {
         double x, y;
         unsigned int age, rayon;
         int statut_sca_int, corail_id_cible = -1;
@@ -194,7 +317,7 @@ void Simulation::readScavenger(std::ifstream& file, int count) {
         Scavenger scavenger(S2d{x, y}, age, rayon, statut_sca, corail_id_cible);
         // Validate the scavenger data here before creating an instance
         if (validateScavenger(scavenger)) {
-            scavengerVec.push_back(scavenger);  // Add the scavenger to the vector
+            add_Scavenger_To_Simulation(scavenger);  // also finds its target
         } else {
             // std::cerr << "Invalid scavenger data at entry " << i << std::endl;
             //  Handle invalid scavenger data appropriately
@@ -203,7 +326,7 @@ void Simulation::readScavenger(std::ifstream& file, int count) {
 }
 
 //-------------------validateCoral-------------------
-bool Simulation::validateCoral(const Coral& coral) const {
+bool Simulation::validateCoral(const Coral& coral) {
     if (!validateCoral_pos(coral)) {
         readFileSuccess = false;
         return false;
@@ -246,8 +369,8 @@ bool Simulation::validateCoral(const Coral& coral) const {
 }
 
 bool Simulation::validate_coral_age(const Coral& coral) const {
-    if (coral.getAge() <= 0) {
-        std::cout << message::lifeform_age(coral.getAge());
+    if (coral.getAge(tick) <= 0) {
+        std::cout << message::lifeform_age(coral.getAge(tick));
 
         // exit(EXIT_FAILURE);
         return false;
@@ -285,9 +408,9 @@ bool Simulation::validateCoral_pos(const Coral& coral) const {
     return true;
 }
 
-bool Simulation::validateCoralUniqueID(const Coral& coral) const {
+bool Simulation::validateCoralUniqueID(const Coral& coral) {
     // Attempt to add the coral's ID to the set of unique IDs
-    bool isUnique = Coral::addUniqueID(coral.getID());
+    bool isUnique = coral_IDs.insert(coral.getID());
 
     if (!isUnique) {
         // If the ID was already in the set, it's not unique
@@ -324,8 +447,8 @@ bool Simulation::validateCoralSegmentLengths(const Coral& coral) const {
     return true;
 }
 bool Simulation::validateCoralSegmentsSuperposition(const Coral& coral) const {
-    auto segments = coral.getSegments();  // segments:vecteur de segment(autoplus
-                                          // jolie)
+    const auto& segments = coral.getSegments();  // segments:vecteur de segment
+                                                 // (autoplus jolie)
     // First, check each segment against every other segment for superposition
     for (size_t i = 0; i < segments.size(); ++i) {
         for (size_t j = i + 1; j < segments.size(); ++j) {
@@ -360,7 +483,7 @@ bool Simulation::validateCoral_other_Segments_Superposition(const Coral& coral)
 }
 
 bool Simulation::validateCoral_self_SegmentsIntersect(const Coral& coral) const {
-    std::vector<Segment> segments = coral.getSegments();
+    const SegmentVector& segments = coral.getSegments();
     /* std::cout << "------------helloo---------------" << std::endl;
     std::cout << "segments size: " << segments.size() << std::endl; */
 
@@ -404,7 +527,7 @@ bool Simulation::validateCoral_other_SegmentsIntersect(const Coral& coral) const
     return true;  // No intersections found
 }
 //-------------------validateScavenger-------------------
-bool Simulation::validateScavenger(const Scavenger& scavenger) const {
+bool Simulation::validateScavenger(const Scavenger& scavenger) {
     if (!validate_scavenger_pos(scavenger)) {
         readFileSuccess = false;
         return false;
@@ -435,8 +558,8 @@ bool Simulation::validate_scavenger_pos(const Scavenger& scavenger) const {
     return true;
 }
 bool Simulation::validate_scavenger_age(const Scavenger& scavenger) const {
-    if (scavenger.getAge() <= 0) {
-        std::cout << message::lifeform_age(scavenger.getAge());
+    if (scavenger.getAge(tick) <= 0) {
+        std::cout << message::lifeform_age(scavenger.getAge(tick));
         // exit(EXIT_FAILURE);
         return false;
     }
@@ -474,66 +597,209 @@ bool Simulation::validate_sca_corail_cible(const Scavenger& scavenger) const {
 
 void Simulation::reportError(const std::string& errorMessage) const {
     std::cerr << errorMessage << std::endl;
-    exit(EXIT_FAILURE);
 }
 
 //____file_saving_________
 
 void Simulation::saveSimulation(const std::string& filename) {
+    saveState(filename, algaeVec, coralVec, scavengerVec, tick);
+}
+
+void Simulation::takeSnapshot(Snapshot& snapshot) const {
+    TRACE_SCOPE("takeSnapshot");
+    // copy assignment keeps the capacity of the vectors, and of the segments
+    snapshot.algae = algaeVec;
+    snapshot.corals = coralVec;
+    snapshot.scavengers = scavengerVec;
+    snapshot.tick = tick;
+    takeResumeState(snapshot);
+}
+
+void Simulation::takeResumeState(Snapshot& snapshot) const {
+    std::ostringstream engine;
+    engine << e;
+    snapshot.random_engine = engine.str();
+    snapshot.next_coral_ID = next_coral_ID;
+    snapshot.random_mode = random_mode;
+    snapshot.random_seed = random_seed;
+}
+
+void Simulation::restore(const Snapshot& snapshot) {
+    TRACE_SCOPE("restore");
+    clearAllEntities();
+    tick = snapshot.tick;  // before the deaths are scheduled
+    algaeVec.reserve(snapshot.algae.size());
+    coralVec.reserve(snapshot.corals.size());
+    scavengerVec.reserve(snapshot.scavengers.size());
+    for (const auto& algae : snapshot.algae) {
+        add_Algae_To_Simulation(algae);
+    }
+    std::unordered_map<int, Handle> coral_of_ID;  // one pass for all the targets
+    coral_of_ID.reserve(snapshot.corals.size());
+    for (const auto& coral : snapshot.corals) {
+        coral_of_ID.emplace(coral.getID(), add_Coral_To_Simulation(coral));
+    }
+    for (const auto& scavenger : snapshot.scavengers) {
+        Scavenger restored(scavenger);  // its handle named a coral of another table
+        auto target = coral_of_ID.find(scavenger.getTargetCoralId());
+        restored.set_targetCoral(target != coral_of_ID.end() ? target->second
+                                                             : no_handle);
+        add_Scavenger_To_Simulation(restored);
+    }
+    if (snapshot.next_coral_ID > 0) {
+        next_coral_ID = snapshot.next_coral_ID;
+    }
+    if (!snapshot.random_engine.empty()) {
+        // the seed first, it also seeds the engine
+        random_mode = snapshot.random_mode;
+        setRandomSeed(snapshot.random_seed);
+        std::istringstream engine(snapshot.random_engine);
+        engine >> e;
+    }
+}
+
+bool Simulation::saveSnapshot(const Snapshot& snapshot, const std::string& filename) {
+    return saveState(filename, snapshot.algae, snapshot.corals, snapshot.scavengers,
+                     snapshot.tick);
+}
+
+bool Simulation::saveState(const std::string& filename,
+                           const std::vector<Algae>& algae,
+                           const std::vector<Coral>& corals,
+                           const std::vector<Scavenger>& scavengers,
+                           unsigned long now) {
+    TRACE_SCOPE("saveSimulation");
     std::ofstream outFile(filename);
 
     if (!outFile) {
         // Handle error - unable to open file for writing
         std::cerr << "Error: Unable to open file " << filename << " for writing."
                   << std::endl;
-        return;
+        return false;
     }
 
     // Write the header or any initial comments
     outFile << "# Simulation State File\n" << std::endl;
 
     // Save each entity type
-    saveAlgae(outFile);
+    saveAlgae(outFile, algae, now);
     outFile << "\n";
-    saveCorals(outFile);
-    saveScavengers(outFile);
+    saveCorals(outFile, corals, now);
+    saveScavengers(outFile, scavengers, now);
 
+    // a write that failed (a full disk) only shows in the state of the stream
     outFile.close();
+    if (!outFile) {
+        std::cerr << "Error: Unable to write file " << filename << '.' << std::endl;
+        return false;
+    }
+    return true;
 }
 
-void Simulation::saveAlgae(std::ofstream& outFile) {
-    outFile << algaeVec.size() << std::endl;
-    for (const auto& algae : algaeVec) {
-        outFile << "    " << algae << std::endl;
+void Simulation::saveAlgae(std::ofstream& outFile, const std::vector<Algae>& algae,
+                           unsigned long now) {
+    outFile << algae.size() << '\n';
+    for (const auto& one_algae : algae) {
+        outFile << "    ";
+        one_algae.write(outFile, now);
+        outFile << '\n';
     }
 }
 
-void Simulation::saveCorals(std::ofstream& outFile) {
-    outFile << coralVec.size() << std::endl;
-    for (const auto& coral : coralVec) {
-        outFile << "    " << coral << std::endl;
+void Simulation::saveCorals(std::ofstream& outFile, const std::vector<Coral>& corals,
+                            unsigned long now) {
+    outFile << corals.size() << '\n';
+    for (const auto& coral : corals) {
+        outFile << "    ";
+        coral.write(outFile, now);
+        outFile << '\n';
     }
 }
 
-void Simulation::saveScavengers(std::ofstream& outFile) {
-    outFile << scavengerVec.size() << std::endl;
-    for (const auto& scavenger : scavengerVec) {
-        outFile << "    " << scavenger << std::endl;
+void Simulation::saveScavengers(std::ofstream& outFile,
+                                const std::vector<Scavenger>& scavengers,
+                                unsigned long now) {
+    outFile << scavengers.size() << '\n';
+    for (const auto& scavenger : scavengers) {
+        outFile << "    ";
+        scavenger.write(outFile, now);
+        outFile << '\n';
     }
 }
 
 void Simulation::clearAllEntities() {
     algaeVec.clear();
     coralVec.clear();
-    Coral::clear_uniqueIDs();
+    coral_IDs.clear();
+    next_coral_ID = 1;
     scavengerVec.clear();
-    Scavenger::clear_targetIDs();
+    algae_handles.clear();
+    coral_handles.clear();
+    scavenger_handles.clear();
+    targeted_IDs.clear();
+    ++static_revision;
+    tick = 0;
+    for (auto& due : death_wheel) {
+        due.algae.clear();  // keeps the storage
+        due.corals = 0;
+        due.scavengers = 0;
+    }
 }
 
 void Simulation::updateEntities() {
+    TRACE_SCOPE("updateEntities");
+#ifdef MICROREEF_STATS
+    stats::Registry before = stats::thread_registry;
+#endif
+    ++tick;
     updateAlgae();
     updateCorals();
     updateScavengers();
+#ifdef MICROREEF_STATS
+    last_tick_stats = stats::difference(stats::thread_registry, before);
+#endif
+}
+
+void Simulation::runTicks(unsigned long count) {
+    unsigned long end = tick + count;
+    while (tick < end) {
+        if (isQuiescent()) {
+            unsigned long next = next_death_tick(end);
+            if (next == 0) {
+                tick = end;  // nothing at all happens until the end
+                break;
+            }
+            tick = next - 1;  // the updates in between change nothing but the ages
+        }
+        updateEntities();
+    }
+}
+
+bool Simulation::isQuiescent() const {
+    if (algae_birth_allowed) {
+        return false;  // one random draw every update
+    }
+    bool untargeted_dead_coral = false;
+    for (const auto& coral : coralVec) {
+        if (coral.getStatut() == ALIVE) {
+            return false;
+        }
+        if (!targeted_IDs.contains(coral.getID())) {
+            untargeted_dead_coral = true;
+        }
+    }
+    // mirrors updateScavengers: a free scavenger without target looks for a dead
+    // coral nobody targets, the others act only if their target still exists
+    for (const auto& scavenger : scavengerVec) {
+        if (scavenger.getStatus() == LIBRE && scavenger.getTargetCoralId() == -1) {
+            if (untargeted_dead_coral) {
+                return false;
+            }
+        } else if (getCoral(scavenger.get_targetCoral()) != nullptr) {
+            return false;
+        }
+    }
+    return true;
 }
 
 void Simulation::print_algae_vector_with_age() const {
@@ -542,40 +808,59 @@ void Simulation::print_algae_vector_with_age() const {
     std::cout << "Max algae age: " << max_life_alg << std::endl;
     for (const auto& algae : algaeVec) {
         std::cout << "Algae at position (" << algae.getPosition().x << ", "
-                  << algae.getPosition().y << ") with age " << algae.getAge()
+                  << algae.getPosition().y << ") with age " << algae.getAge(tick)
                   << std::endl;
     }
 }
 
 void Simulation::updateAlgae() {
+    TRACE_SCOPE("updateAlgae");
+    STATS_SCOPE(UPDATE_ALGAE);
     death_to_algae();
     algae_generator();
 }
 
 void Simulation::death_to_algae() {
-    // std::cout << "checking death to algae" << std::endl;
-    for (size_t i = 0; i < algaeVec.size(); ++i) {
-        algaeVec[i].incrementAge();
-        if (algaeVec[i].getAge() >= max_life_alg) {
-            algaeVec.erase(algaeVec.begin() + i);
-            Algae::decrementNbAlg();
-            i--;  // Decrement i to adjust for the removed element
+    // only the algae that die are touched, they leave algaeVec with the ones eaten
+    // in the compaction at the end of updateCorals
+    DueDeaths& due = death_slot(tick);
+    for (Handle algae : due.algae) {
+        if (algae_handles.isValid(algae)) {
+            algae_handles.remove(algae_handles.position(algae));
         }
     }
-    // printEntitiesSize();
-    // print_algae_vector_with_age();
+    due.algae.clear();
 }
 
 void Simulation::algae_generator() {
     // generate new algae
     if (algae_birth_allowed) {
-        if (algaeCreationDistribution(e)) {
-            // Generate a random position for the new algae
-            double x = positionDistribution(e);
-            double y = positionDistribution(e);
+        bool born;
+        double x(0);
+        double y(0);
+        if (random_mode == ENGINE) {
+            born = algaeCreationDistribution(e);
+            if (born) {
+                // Generate a random position for the new algae
+                x = positionDistribution(e);
+                y = positionDistribution(e);
+            }
+        } else {
+            // one birth at most per update, the draws of event id 0
+            auto draws = counter_random.draws(tick, CounterRandom::ALGAE_BIRTH, 0);
+            born = draws.bernoulli(algaeCreationDistribution.p());
+            if (born) {
+                unsigned first = positionDistribution.a();
+                unsigned count = positionDistribution.b() - first + 1;
+                x = first + draws.below(count);
+                y = first + draws.below(count);
+            }
+        }
+        if (born) {
             // Add new algae to the simulation
-            Algae newAlgae(S2d{x, y}, 1);
-            algaeVec.push_back(newAlgae);
+            Algae& newAlgae = algaeVec.emplace_back(S2d{x, y}, 1);
+            newAlgae.setAge(1, tick);
+            schedule_death(newAlgae, algae_handles.add());
             // std::cout << "algae added to vector...." << std::endl;
             //  or use add_Algae_To_Simulation neeed to check which is better practice
         }
@@ -592,8 +877,80 @@ unsigned Simulation::getScavengerCount() const {
     return scavengerVec.size();  // could;ve used nbSca
 }
 
+unsigned long Simulation::getStaticRevision() const {
+    return static_revision;
+}
+
+const stats::Registry& Simulation::getLastTickStats() const {
+    return last_tick_stats;
+}
+
+unsigned long Simulation::getTick() const {
+    return tick;
+}
+
+bool Simulation::getReadFileSuccess() const {
+    return readFileSuccess;
+}
+
+Simulation::DueDeaths& Simulation::death_slot(unsigned long at) {
+    return death_wheel[at % death_wheel.size()];
+}
+
+unsigned long Simulation::next_death_tick(unsigned long limit) {
+    // every scheduled death is less than a wheel turn away
+    unsigned long horizon = std::min<unsigned long>(limit, tick + death_wheel.size());
+    for (unsigned long at = tick + 1; at <= horizon; ++at) {
+        const DueDeaths& due = death_slot(at);
+        if (!due.algae.empty() || due.corals > 0 || due.scavengers > 0) {
+            return at;
+        }
+    }
+    return 0;
+}
+
+void Simulation::schedule_death(const Algae& algae, Handle handle) {
+    // dies at the first update where its age reaches max_life_alg
+    long long death =
+        std::max<long long>(algae.getBirthTick() + max_life_alg, tick + 1);
+    death_slot(death).algae.push_back(handle);
+}
+
+void Simulation::schedule_death(const Coral& coral) {
+    // dies when its age is exactly max_life_cor, a coral older than that never does
+    long long death = coral.getBirthTick() + max_life_cor;
+    if (death > static_cast<long long>(tick)) {
+        ++death_slot(death).corals;
+    }
+}
+
+void Simulation::schedule_death(const Scavenger& scavenger) {
+    long long death = scavenger.getBirthTick() + max_life_sca;  // same rule as corals
+    if (death > static_cast<long long>(tick)) {
+        ++death_slot(death).scavengers;
+    }
+}
+
 void Simulation::resetRandomEngineForNewFile() {
-    e.seed(1);  // Re-seed the engine with a fixed value for reproducibility
+    e.seed(random_seed);  // Re-seed the engine with a fixed value for reproducibility
+}
+
+void Simulation::setRandomMode(RandomMode mode) {
+    random_mode = mode;
+}
+
+Simulation::RandomMode Simulation::getRandomMode() const {
+    return random_mode;
+}
+
+void Simulation::setRandomSeed(unsigned long seed) {
+    random_seed = seed;
+    e.seed(random_seed);
+    counter_random.seed(random_seed);
+}
+
+unsigned long Simulation::getRandomSeed() const {
+    return random_seed;
 }
 
 void Simulation::startAlgaeBirth() {
@@ -604,16 +961,43 @@ void Simulation::stopAlgaeBirth() {
     algae_birth_allowed = false;
 }
 
-void Simulation::add_Algae_To_Simulation(const Algae& algae) {
+Handle Simulation::add_Algae_To_Simulation(const Algae& algae) {
     algaeVec.push_back(algae);
+    Handle handle = algae_handles.add();
+    schedule_death(algae, handle);
+    return handle;
+}
+
+Handle Simulation::add_Coral_To_Simulation(const Coral& coral) {
+    return add_Coral_To_Simulation(Coral(coral));
+}
+
+Handle Simulation::add_Coral_To_Simulation(Coral&& coral) {
+    coral_IDs.insert(coral.getID());  // already there when it was read
+    schedule_death(coral);
+    if (coral.getStatut() == DEAD) {
+        ++static_revision;
+    }
+    coralVec.push_back(std::move(coral));
+    return coral_handles.add();
+}
+
+Handle Simulation::add_Scavenger_To_Simulation(const Scavenger& scavenger) {
+    Scavenger& added = scavengerVec.emplace_back(scavenger);
+    if (added.getTargetCoralId() != -1) {
+        targeted_IDs.insert(added.getTargetCoralId());
+    }
+    resolve_target(added);
+    schedule_death(added);
+    return scavenger_handles.add();
 }
 
-void Simulation::add_Coral_To_Simulation(const Coral& coral) {
-    coralVec.push_back(coral);
+void Simulation::setAssignment(Assignment mode) {
+    assignment_mode = mode;
 }
 
-void Simulation::add_Scavenger_To_Simulation(const Scavenger& scavenger) {
-    scavengerVec.push_back(scavenger);
+Simulation::Assignment Simulation::getAssignment() const {
+    return assignment_mode;
 }
 
 bool Simulation::getAlgaeBirthAllowed() const {
@@ -650,18 +1034,19 @@ void Simulation::printEntitiesSize() const {
     std::cout << "Scavenger vector size: " << scavengerVec.size() << std::endl;
 }
 
-std::vector<Algae> Simulation::get_algae_in_simulation() const {
+const std::vector<Algae>& Simulation::get_algae_in_simulation() const {
     return algaeVec;
 }
-std::vector<Coral> Simulation::get_coral_in_simulation() const {
+const std::vector<Coral>& Simulation::get_coral_in_simulation() const {
     return coralVec;
 }
-std::vector<Scavenger> Simulation::get_scavenger_in_simulation() const {
+const std::vector<Scavenger>& Simulation::get_scavenger_in_simulation() const {
     return scavengerVec;
 }
 
 void Simulation::updateCorals() {
-    std::vector<Coral> temporary_coral_vector;
+    TRACE_SCOPE("updateCorals");
+    STATS_SCOPE(UPDATE_CORALS);
     death_to_corals();
     for (auto& coral : coralVec) {
         if (coral.getStatut() == DEAD) {
@@ -682,13 +1067,11 @@ void Simulation::updateCorals() {
                 }
             } else {
                 // reproduce_Coral_by_division(coral);
-                const Coral old_coral = coral;
-                Coral new_baby_coral = generate_coralOffspring(old_coral);
+                Coral new_baby_coral = generate_coralOffspring(coral);
                 if (new_baby_coral.getID() == -42) {
                     std::cerr << "new baby coral is invalid" << std::endl;
                 } else {
-                    temporary_coral_vector.push_back(new_baby_coral);
-                    coral = old_coral;
+                    coral_births.push_back(std::move(new_baby_coral));
                     Segment lastSegment = coral.get_last_segment();
                     coral.set_last_segment_length(lastSegment.getLength() / 2);
                 }
@@ -696,16 +1079,32 @@ void Simulation::updateCorals() {
             }
         }
     }
-    // merge the temporary vector with the original vector
-    coralVec.insert(coralVec.end(), temporary_coral_vector.begin(),
-                    temporary_coral_vector.end());
+    // move the babies at the end of the vector, their segments are not copied
+    for (const auto& baby_coral : coral_births) {
+        schedule_death(baby_coral);
+    }
+    coralVec.insert(coralVec.end(), std::make_move_iterator(coral_births.begin()),
+                    std::make_move_iterator(coral_births.end()));
+    for (size_t i = 0; i < coral_births.size(); ++i) {
+        coral_handles.add();
+    }
+    coral_births.clear();
+    compact_entities(algaeVec, algae_handles);  // the algae eaten
 }
 
 void Simulation::updateScavengers() {
+    TRACE_SCOPE("updateScavengers");
+    STATS_SCOPE(UPDATE_SCAVENGERS);
     death_to_scavengers();
+    if (assignment_mode == GLOBAL) {
+        assignTargetsGlobally();  // the loop below then only moves them
+    }
     for (auto& scavenger : scavengerVec) {
         if (scavenger.getStatus() == LIBRE) {
             if (scavenger.getTargetCoralId() == -1) {
+                if (assignment_mode == GLOBAL) {
+                    continue;  // no coral was left for it in assignTargetsGlobally
+                }
                 // move to DEad coral disponible le plus proche, deplacement
                 Coral* nearestDeadCoral =
                     findNearestDeadCoral(scavenger.getPosition());
@@ -713,12 +1112,14 @@ void Simulation::updateScavengers() {
                     // std::cout << "no dead corals found" << std::endl;
                 } else {
                     scavenger.set_targetCoralId(nearestDeadCoral->getID());
+                    scavenger.set_targetCoral(
+                        coral_handles.handleAt(nearestDeadCoral - coralVec.data()));
+                    targeted_IDs.insert(nearestDeadCoral->getID());
                     moveScavenger_toDeadCoral(scavenger, nearestDeadCoral);
-                    Scavenger::addTargetID(nearestDeadCoral->getID());
                 }
             } else {
                 // move to the target coral
-                Coral* targetCoral = findCoralById(scavenger.getTargetCoralId());
+                Coral* targetCoral = findCoral(scavenger.get_targetCoral());
                 if (targetCoral == nullptr) {
                     // std::cout << "no target corals found" << std::endl;
                 } else {
@@ -730,14 +1131,23 @@ void Simulation::updateScavengers() {
             scavengerFeedsOnCoral(scavenger);
         }
     }
+    compact_entities(coralVec, coral_handles);  // the corals eaten
+    generateScavengerOffspring();
 }
 
 void Simulation::death_to_corals() {
+    DueDeaths& due = death_slot(tick);
+    if (due.corals == 0) {
+        return;
+    }
+    due.corals = 0;
     for (size_t i(0); i < coralVec.size(); ++i) {
         // check if coral's age is equal to max_life_cor if so kill it aka change kill
         // it using the killCoral() method
-        coralVec[i].incrementAge();
-        if (coralVec[i].getAge() == max_life_cor) {
+        if (coralVec[i].getAge(tick) == max_life_cor) {
+            if (coralVec[i].getStatut() == ALIVE) {
+                ++static_revision;  // the coral joins the static layer
+            }
             coralVec[i].killCoral();
         }
     }
@@ -746,32 +1156,24 @@ void Simulation::death_to_corals() {
 void Simulation::death_to_scavengers() {
     // ckeck scavenger's age is equal to max_life_sca if so kill it aka remove it from
     // the sim aka from the vector
-    for (size_t i = 0; i < scavengerVec.size(); ++i) {
-        scavengerVec[i].incrementAge();
-        if (scavengerVec[i].getAge() == max_life_sca) {
-            scavengerVec.erase(scavengerVec.begin() + i);
-            Scavenger::decrementNbScavengers();
-            i--;  // Decrement i to adjust for the removed element
-        }
+    DueDeaths& due = death_slot(tick);
+    if (due.scavengers == 0) {
+        return;
     }
+    due.scavengers = 0;
+    erase_entities_if(scavengerVec, scavenger_handles,
+                      [this](const Scavenger& scavenger) {
+                          return scavenger.getAge(tick) == max_life_sca;
+                      });
 }
 
 unsigned int Simulation::generateNewUniqueID() {
-    // Retrieve the current set of unique IDs from the Coral class.
-    std::set<int>& uniqueIDs = Coral::getUniqueIDs();
-
-    // Initialize the new ID to start searching from.
-    static unsigned int generated_unique_ID = 1;
-
-    // Increment to find a unique ID not in the set.
-    while (uniqueIDs.count(generated_unique_ID) != 0) {
-        ++generated_unique_ID;
+    // probe upward from the last ID given until a free one is found; O(1) on
+    // average
+    while (!coral_IDs.insert(next_coral_ID)) {
+        ++next_coral_ID;
     }
-
-    // After finding a unique ID, ensure it gets added to the set in the Coral class.
-    uniqueIDs.insert(generated_unique_ID);
-
-    return generated_unique_ID;
+    return next_coral_ID;
 }
 
 void Simulation::rotateCoral(Coral& coral) {
@@ -818,7 +1220,8 @@ void Simulation::rotateCorals() {
 }
 
 bool Simulation::checkCoralIntersection(const Coral& coral) const {
-    auto segments = coral.getSegments();
+    STATS_SCOPE(CORAL_INTERSECTION);
+    const auto& segments = coral.getSegments();
     if (segments.empty())
         return false;  // No segments to check
 
@@ -836,7 +1239,7 @@ bool Simulation::checkCoralIntersection(const Coral& coral) const {
     for (const auto& otherCoral : coralVec) {
         if (&coral == &otherCoral)
             continue;
-        auto otherSegments = otherCoral.getSegments();
+        const auto& otherSegments = otherCoral.getSegments();
         for (const auto& segment : otherSegments) {
             if (lastSegment.doIntersect(lastSegment, segment)) {
                 return true;
@@ -851,7 +1254,8 @@ bool Simulation::checkCoralIntersection(const Coral& coral) const {
 // fix it
 
 bool Simulation::sweepingPassDetected(const Coral& coral) const {
-    auto segments = coral.getSegments();
+    STATS_SCOPE(SWEEPING_PASS);
+    const auto& segments = coral.getSegments();
     if (segments.size() < 2)
         return false;  // Not enough segments to check
 
@@ -873,6 +1277,8 @@ bool Simulation::sweepingPassDetected(const Coral& coral) const {
     std::vector<S2d> sweepingArc;
     sweepingArc.push_back(lastSegmentExtremityBefore);
     double direction = (delta_rot > 0) ? 1 : -1;
+    // cos/sin per intermediate point, atan2/hypot per arc segment
+    STATS_ADD(TRIG_CALLS, 2 * (numIntermediatePoints - 1) + 2 * numIntermediatePoints);
     for (int i = 1; i < numIntermediatePoints; ++i) {
         double intermediateAngle = lastSegment.getAngle() + direction * i *
                                                                 std::fabs(delta_rot) /
@@ -901,13 +1307,17 @@ bool Simulation::sweepingPassDetected(const Coral& coral) const {
 }
 
 void Simulation::checkAndConsumeAlgae(Coral& coral) {
+    STATS_SCOPE(CONSUME_ALGAE);
     if (coral.getStatut() == DEAD) {
         return;  // Do not consume algae if the coral is dead
     }
     double hitbox_algae = epsil_zero * 1.2;
     for (size_t i = 0; i < algaeVec.size(); ++i) {
+        // an algae eaten by a coral before this one is still there until the end
+        // of updateCorals, only looked at on a hit
         if (coral.get_last_segment().intersectsCircle(algaeVec[i].getPosition(),
-                                                      hitbox_algae)) {
+                                                      hitbox_algae) &&
+            !algae_handles.isRemoved(i)) {
             // Attempt to extend the coral's last segment
             coral.extend_last_segment(delta_l);
             // Check for boundary and intersection conditions
@@ -925,8 +1335,8 @@ void Simulation::checkAndConsumeAlgae(Coral& coral) {
                 coral.decrease_last_segment_length(delta_l);
 
             } else {
-                // Valid extension, remove the algae
-                algaeVec.erase(algaeVec.begin() + i);
+                // Valid extension, remove the algae (at the end of updateCorals)
+                algae_handles.remove(i);
                 break;  // Only one algae is consumed per rotation
             }
         }
@@ -936,7 +1346,8 @@ void Simulation::checkAndConsumeAlgae(Coral& coral) {
 bool Simulation::coral_algae_intersrct(Coral& coral) {
     for (size_t i = 0; i < algaeVec.size(); ++i) {
         if (coral.get_last_segment().intersectsCircle(algaeVec[i].getPosition(),
-                                                      r_alg)) {
+                                                      r_alg) &&
+            !algae_handles.isRemoved(i)) {
             return true;
         }
     }
@@ -970,7 +1381,6 @@ void Simulation::reproduce_Coral_by_division(Coral& coral) {
     S2d new_coral_base = {lastSegmentExtremity.x - offset * std::cos(angle),
                           lastSegmentExtremity.y - offset * std::sin(angle)};
     unsigned int new_coral_Id = generateNewUniqueID();
-    Coral::addUniqueID(new_coral_Id);
     Coral newCoral(new_coral_base, 1, new_coral_Id, ALIVE,
                    coral.getDirectionRotation(), EXTEND, 1, angle,
                    l_repro - l_seg_interne);
@@ -988,7 +1398,7 @@ void Simulation::reproduce_Coral_by_division(Coral& coral) {
 } */ // problem here, need to investigate why the old coral becomes 0000000 but after
 // rendu 3
 
-Coral Simulation::generate_coralOffspring(Coral coral) {
+Coral Simulation::generate_coralOffspring(const Coral& coral) {
     if (coral.getSegments().empty()) {
         std::cerr << "Error: Trying to reproduce a coral with no segments, coral ID: "
                   << coral.getID() << "\n";
@@ -1015,57 +1425,89 @@ Coral Simulation::generate_coralOffspring(Coral coral) {
     S2d new_coral_base = {lastSegmentExtremity.x - offset * std::cos(angle),
                           lastSegmentExtremity.y - offset * std::sin(angle)};
     unsigned int new_coral_Id = generateNewUniqueID();
-    Coral::addUniqueID(new_coral_Id);
     // std::cout << "old coral after new coral id generation" << coral << std::endl;
     Coral newCoral(new_coral_base, 1, new_coral_Id, ALIVE,
                    coral.getDirectionRotation(), EXTEND, 1, angle,
                    l_repro - l_seg_interne);
+    newCoral.setAge(1, tick);
     // std::cout << "new coral after reproduction" << newCoral << std::endl;
     // std::cout << "old coral after reproduction" << coral << std::endl;
     // same problem here, after this line the old coral becomes 0000000
     return newCoral;
 }
 
-void Simulation::generateScavengerOffspring(S2d position_Of_baby_scavenger) {
-    for (auto& scavenger : scavengerVec) {
-        if (scavenger.getRadius() >= r_sca_repro) {
-            // reproduce by division
-            // new position on the line ofthe eaten coral but with a distance of
-            // delta_l of the parent scavenger
-            Scavenger newScavenger(position_Of_baby_scavenger, 1, r_sca, LIBRE);
-            scavenger.setRadius(r_sca);
-            add_Scavenger_To_Simulation(newScavenger);
-        }
+void Simulation::generateScavengerOffspring() {
+    for (const auto& position_Of_baby_scavenger : scavenger_births) {
+        Scavenger& newScavenger =
+            scavengerVec.emplace_back(position_Of_baby_scavenger, 1, r_sca, LIBRE);
+        scavenger_handles.add();
+        newScavenger.setAge(1, tick);
+        schedule_death(newScavenger);
     }
+    scavenger_births.clear();
 }
 
 // le corail disparait des que tt ses segment sont consomes
 void Simulation::remove_eaten_corals_from_simulation() {
+    size_t before = coralVec.size();
+    erase_entities_if(coralVec, coral_handles, [this](const Coral& coral) {
+        if (!coral.getSegments().empty()) {
+            return false;
+        }
+        // remove the coral's id from the set of unique IDs and from the set of
+        // target IDs
+        coral_IDs.erase(coral.getID());
+        targeted_IDs.erase(coral.getID());
+        return true;
+    });
+    if (coralVec.size() != before) {
+        ++static_revision;
+    }
+}
+
+void Simulation::assignTargetsGlobally() {
+    STATS_SCOPE(ASSIGN_TARGETS);
+    std::vector<S2d> seekers, targets;
+    std::vector<Scavenger*> free_scavengers;
+    std::vector<size_t> target_positions;  // in coralVec
+    for (auto& scavenger : scavengerVec) {
+        if (scavenger.getStatus() == LIBRE && scavenger.getTargetCoralId() == -1) {
+            seekers.push_back(scavenger.getPosition());
+            free_scavengers.push_back(&scavenger);
+        }
+    }
+    if (seekers.empty()) {
+        return;
+    }
     for (size_t i = 0; i < coralVec.size(); ++i) {
-        if (coralVec[i].getSegments().empty()) {
-            // remove the coral's id from the set of unique IDs and from the set of
-            // target IDs
-            Coral::removeUniqueID(coralVec[i].getID());
-            Scavenger::removeTargetID(coralVec[i].getID());
-            coralVec.erase(coralVec.begin() + i);
-            Coral::decrementNbCoral();
-            i--;  // Decrement i to adjust for the removed element
+        const Coral& coral = coralVec[i];
+        if (coral.getStatut() == DEAD && !coral_handles.isRemoved(i) &&
+            !targeted_IDs.contains(coral.getID())) {
+            targets.push_back(coral.getPosition());
+            target_positions.push_back(i);
+        }
+    }
+    std::vector<int> matches = assignment::match_nearest(seekers, targets);
+    for (size_t i = 0; i < matches.size(); ++i) {
+        if (matches[i] >= 0) {
+            size_t position = target_positions[matches[i]];
+            free_scavengers[i]->set_targetCoralId(coralVec[position].getID());
+            free_scavengers[i]->set_targetCoral(coral_handles.handleAt(position));
+            targeted_IDs.insert(coralVec[position].getID());
         }
     }
 }
 
 Coral* Simulation::findNearestDeadCoral(const S2d& position) {
+    STATS_SCOPE(NEAREST_DEAD_CORAL);
     Coral* nearest = nullptr;
     double minDistance = std::numeric_limits<double>::max();
     // initializing the minDistance to the max value of double
-    std::set<unsigned int> targetedIDs = Scavenger::getTargetIDs();
-
-    // print out the targetedIDs and coralids
-    // Scavenger::printTargetIDs();
 
-    for (auto& coral : coralVec) {
-        if (coral.getStatut() == DEAD &&
-            targetedIDs.find(coral.getID()) == targetedIDs.end()) {
+    for (size_t i = 0; i < coralVec.size(); ++i) {
+        Coral& coral = coralVec[i];
+        if (coral.getStatut() == DEAD && !coral_handles.isRemoved(i) &&
+            !targeted_IDs.contains(coral.getID())) {
             double distance = calculateDistance(coral.getPosition(), position);
             if (distance < minDistance) {
                 minDistance = distance;
@@ -1078,15 +1520,16 @@ Coral* Simulation::findNearestDeadCoral(const S2d& position) {
 
 // alimentation sur le corail mort par deplacement de delta_l
 void Simulation::scavengerFeedsOnCoral(Scavenger& scavenger) {
-    Coral* coral = findCoralById(scavenger.getTargetCoralId());
+    Coral* coral = findCoral(scavenger.get_targetCoral());
     if (coral == nullptr) {
         return;  // If there is no dead coral, do nothing.
     }
+    ++static_revision;  // the dead coral is eaten, removed or shortened
     if (coral->getSegments().empty() ||
         coral->getPosition() == scavenger.getPosition()) {
-        Coral::removeUniqueID(coral->getID());
-        Scavenger::removeTargetID(coral->getID());
-        remove_Coral_From_Simulation(*coral);
+        coral_IDs.erase(coral->getID());
+        targeted_IDs.erase(coral->getID());
+        discard_coral(*coral);
         scavenger.setStatus(LIBRE);
         scavenger.set_targetCoralId(-1);
         return;  // No segments to consume.
@@ -1117,9 +1560,15 @@ void Simulation::scavengerFeedsOnCoral(Scavenger& scavenger) {
     }  // if the coral is  completly consumed, change the scavenger's status to LIBRE,
        // and set the target id to -1
     if (scavenger.getRadius() >= r_sca_repro) {
+        // reproduce by division, the baby is added after the update of all the
+        // scavengers (generateScavengerOffspring): only the one feeding can cross
+        // r_sca_repro, the others were reset when they did
+        // new position on the line ofthe eaten coral but with a distance of
+        // delta_l of the parent scavenger
         S2d position_Of_baby_scavenger = {last_segment_Extremite.x + delta_l,
                                           last_segment_Extremite.y + delta_l};
-        generateScavengerOffspring(position_Of_baby_scavenger);
+        scavenger.setRadius(r_sca);
+        scavenger_births.push_back(position_Of_baby_scavenger);
     }
 }
 
@@ -1129,11 +1578,12 @@ void Simulation::moveScavenger_toDeadCoral(Scavenger& scavenger, Coral* coral) {
         return;  // If there is no dead coral, do nothing.
     }
     if (coral->getSegments().empty()) {
-        Coral::removeUniqueID(coral->getID());
-        Scavenger::removeTargetID(coral->getID());
-        remove_Coral_From_Simulation(*coral);
+        coral_IDs.erase(coral->getID());
+        targeted_IDs.erase(coral->getID());
+        discard_coral(*coral);
         scavenger.setStatus(LIBRE);
         scavenger.set_targetCoralId(-1);
+        return;  // nothing left to move to
     }
     if (scavenger.getPosition() == coral->get_last_segment().calculate_extremite()) {
         // change the scavenger's status to MANGE
@@ -1172,34 +1622,102 @@ Coral* Simulation::findCoralById(unsigned int coralId) {
     return nullptr;  // Return null if no coral with the specified ID is found
 }
 
+Coral* Simulation::findCoral(Handle coral) {
+    if (!coral_handles.isValid(coral)) {
+        return nullptr;
+    }
+    return &coralVec[coral_handles.position(coral)];
+}
+
+void Simulation::resolve_target(Scavenger& scavenger) {
+    if (scavenger.getTargetCoralId() == -1 ||
+        coral_handles.isValid(scavenger.get_targetCoral())) {
+        return;
+    }
+    if (Coral* coral = findCoralById(scavenger.getTargetCoralId())) {
+        scavenger.set_targetCoral(coral_handles.handleAt(coral - coralVec.data()));
+    }
+}
+
+void Simulation::remove_Algae_From_Simulation(Handle algae) {
+    if (algae_handles.isValid(algae)) {
+        algae_handles.remove(algae_handles.position(algae));
+        compact_entities(algaeVec, algae_handles);
+    }
+}
+
+void Simulation::remove_Coral_From_Simulation(Handle coral) {
+    if (coral_handles.isValid(coral)) {
+        coral_handles.remove(coral_handles.position(coral));
+        compact_entities(coralVec, coral_handles);
+        ++static_revision;
+    }
+}
+
+void Simulation::remove_Scavenger_From_Simulation(Handle scavenger) {
+    if (scavenger_handles.isValid(scavenger)) {
+        scavenger_handles.remove(scavenger_handles.position(scavenger));
+        compact_entities(scavengerVec, scavenger_handles);
+    }
+}
+
+void Simulation::discard_coral(const Coral& coral) {
+    coral_handles.remove(&coral - coralVec.data());
+    ++static_revision;
+}
+
 void Simulation::remove_Algae_From_Simulation(const Algae& algae) {
-    for (size_t i = 0; i < algaeVec.size(); ++i) {
-        if (algaeVec[i] == algae) {
-            algaeVec.erase(algaeVec.begin() + i);
-            Algae::decrementNbAlg();
-            break;
-        }
+    size_t position = position_of(algaeVec, algae);
+    if (position < algaeVec.size()) {
+        remove_Algae_From_Simulation(algae_handles.handleAt(position));
     }
 }
 
 void Simulation::remove_Coral_From_Simulation(const Coral& coral) {
-    for (size_t i = 0; i < coralVec.size(); ++i) {
-        if (coralVec[i] == coral) {
-            coralVec.erase(coralVec.begin() + i);
-            Coral::decrementNbCoral();
-            break;
-        }
+    size_t position = position_of(coralVec, coral);
+    if (position < coralVec.size()) {
+        remove_Coral_From_Simulation(coral_handles.handleAt(position));
     }
 }
 
 void Simulation::remove_Scavenger_From_Simulation(const Scavenger& scavenger) {
-    for (size_t i = 0; i < scavengerVec.size(); ++i) {
-        if (scavengerVec[i] == scavenger) {
-            scavengerVec.erase(scavengerVec.begin() + i);
-            Scavenger::decrementNbScavengers();
-            break;
-        }
+    size_t position = position_of(scavengerVec, scavenger);
+    if (position < scavengerVec.size()) {
+        remove_Scavenger_From_Simulation(scavenger_handles.handleAt(position));
+    }
+}
+
+Handle Simulation::getAlgaeHandle(size_t position) const {
+    return algae_handles.handleAt(position);
+}
+
+Handle Simulation::getCoralHandle(size_t position) const {
+    return coral_handles.handleAt(position);
+}
+
+Handle Simulation::getScavengerHandle(size_t position) const {
+    return scavenger_handles.handleAt(position);
+}
+
+const Algae* Simulation::getAlgae(Handle algae) const {
+    if (!algae_handles.isValid(algae)) {
+        return nullptr;
+    }
+    return &algaeVec[algae_handles.position(algae)];
+}
+
+const Coral* Simulation::getCoral(Handle coral) const {
+    if (!coral_handles.isValid(coral)) {
+        return nullptr;
+    }
+    return &coralVec[coral_handles.position(coral)];
+}
+
+const Scavenger* Simulation::getScavenger(Handle scavenger) const {
+    if (!scavenger_handles.isValid(scavenger)) {
+        return nullptr;
     }
+    return &scavengerVec[scavenger_handles.position(scavenger)];
 }
 
 void Simulation::printCorals() const {
@@ -1214,7 +1732,8 @@ void Simulation::printCorals() const {
         std::cout << "number of segments from NBeg " << coral.getNbSeg() << std::endl;
         std::cout << "number of segments from getSegments() "
                   << coral.getSegments().size() << std::endl;
-        std::cout << coral << std::endl;
+        coral.write(std::cout, tick);
+        std::cout << std::endl;
         std::cout << "______________________________________" << std::endl;
     }
 
@@ -1228,7 +1747,8 @@ void Simulation::printScavengers() const {
 
     for (auto& scavenger : scavengerVec) {
         std::cout << "______________________________________" << std::endl;
-        std::cout << scavenger << std::endl;
+        scavenger.write(std::cout, tick);
+        std::cout << std::endl;
         if (scavenger.getStatus() == MANGE) {
             std::cout << "scavenger is feeding on coral with id: "
                       << scavenger.getTargetCoralId() << std::endl;
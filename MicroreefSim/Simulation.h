@@ -17,46 +17,144 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
 
+#include <functional>
 #include <random>  //for random number generation
 
 #include "Algae.h"
 #include "Coral.h"
+#include "CounterRandom.h"
+#include "Handle.h"
+#include "IdSet.h"
 #include "Scavenger.h"
+#include "Stats.h"
 #include "message.h"
 
 class Simulation {
 public:
     Simulation();
-    void start(const std::string& config_file);
+    // called while a file is read with the fraction read so far (0 to 1), the
+    // reading stops when it returns false
+    using ReadProgress = std::function<bool(double)>;
+    // false when the file cannot be opened or progress stopped the reading, the
+    // simulation is then empty; an invalid file also leaves it empty (the error is
+    // printed) but gives true. Nothing is shared with the other simulations, so
+    // one can be read on another thread while this one runs (FileLoader.h)
+    bool start(const std::string& config_file, const ReadProgress& progress = {});
+    // takes the state of loaded; the static revision keeps growing so a view that
+    // drew this simulation redraws its dead corals
+    void replaceWith(Simulation&& loaded);
+    // an independent copy of the simulation as read and run so far: entities,
+    // handles, tick, random state and modes. It costs one copy of the entities
+    // instead of reading and validating the file again; give the fork another seed
+    // or algae birth to branch from here. It can then run on another thread
+    Simulation fork() const;
     void saveSimulation(const std::string& filename = "simulation_state.txt");
 
+    // where the random draws come from: ENGINE (the default, as in the
+    // specification) is one engine drawn in the order of the updates, COUNTER
+    // computes each draw from the seed, the tick and the id of the event or entity
+    // (CounterRandom.h), so draws do not depend on the order they are made in. The
+    // two modes give different runs
+    enum RandomMode { ENGINE, COUNTER };
+
+    // what saveSimulation writes, copied so that it can be written on another
+    // thread while the simulation goes on (FileSaver.h)
+    struct Snapshot {
+        std::vector<Algae> algae;
+        std::vector<Coral> corals;
+        std::vector<Scavenger> scavengers;
+        unsigned long tick;
+        // the rest of the state restore needs to go on exactly as the run did;
+        // empty and 0 when unknown, e.g. rebuilt from a trajectory file, the
+        // random mode and seed then being those of the simulation restored into
+        std::string random_engine;
+        int next_coral_ID;
+        RandomMode random_mode;
+        unsigned long random_seed;
+    };
+    void takeSnapshot(Snapshot& snapshot) const;  // reuses the storage of snapshot
+    // only random_engine, next_coral_ID, random_mode and random_seed, for a record
+    // of the entities made otherwise (Timeline.h)
+    void takeResumeState(Snapshot& snapshot) const;
+    // same file as saveSimulation, false when it cannot be opened
+    static bool saveSnapshot(const Snapshot& snapshot, const std::string& filename);
+    // goes back to the state of snapshot, the next update is the one that followed
+    // it; the entities get new handles. Algae birth, the assignment and random
+    // modes and the seed stay
+    void restore(const Snapshot& snapshot);
+
     unsigned getAlgaeCount() const;
     unsigned getCoralCount() const;
     unsigned getScavengerCount() const;
+    // changes whenever the static content (dead corals) changes, used by the view
+    unsigned long getStaticRevision() const;
+    // time per phase and counters of the last updateEntities (zero when the
+    // instrumentation is compiled out, see Stats.h)
+    const stats::Registry& getLastTickStats() const;
+    unsigned long getTick() const;  // updates since the file was read
+    bool getReadFileSuccess() const;  // false when the last file read was invalid
     bool getAlgaeBirthAllowed() const;
     bool setAlgaeBirthAllowed(bool value);
     void toggleAlgaeBirthAllowed();
 
     void resetRandomEngineForNewFile();  // random number generation
 
-    void updateEntities();
-    void add_Algae_To_Simulation(const Algae& algae);
-    void add_Coral_To_Simulation(const Coral& coral);
-    void add_Scavenger_To_Simulation(const Scavenger& scavenger);
+    void setRandomMode(RandomMode mode);
+    RandomMode getRandomMode() const;
+    // seeds both generators, now and for every file read after (1 by default)
+    void setRandomSeed(unsigned long seed);
+    unsigned long getRandomSeed() const;
+
+    // how the free scavengers choose a dead coral: GREEDY (the default, as in the
+    // specification) lets each one take the nearest coral left in vector order,
+    // GLOBAL matches them all at once by increasing distance (Assignment.h)
+    enum Assignment { GREEDY, GLOBAL };
+    void setAssignment(Assignment mode);
+    Assignment getAssignment() const;
 
+    void updateEntities();
+    // same result as count calls to updateEntities, but when nothing but deaths
+    // can happen (isQuiescent) it jumps straight to the next update with a death
+    void runTicks(unsigned long count);
+    // algae birth off, no live coral and no scavenger that can reach a coral: the
+    // updates only age the entities until someone dies
+    bool isQuiescent() const;
+    Handle add_Algae_To_Simulation(const Algae& algae);
+    Handle add_Coral_To_Simulation(const Coral& coral);
+    Handle add_Coral_To_Simulation(Coral&& coral);  // takes its segments
+    Handle add_Scavenger_To_Simulation(const Scavenger& scavenger);
+
+    // O(1) to find when given a handle or an entity of the vectors below,
+    // otherwise the first entity equal to the one given is removed; the entities
+    // after it move down in one pass. The updates themselves do not call them,
+    // they mark their removals and compact once per phase (Handle.h)
+    void remove_Algae_From_Simulation(Handle algae);
+    void remove_Coral_From_Simulation(Handle coral);
+    void remove_Scavenger_From_Simulation(Handle scavenger);
     void remove_Algae_From_Simulation(const Algae& algae);
     void remove_Coral_From_Simulation(const Coral& coral);
     void remove_Scavenger_From_Simulation(const Scavenger& scavenger);
 
+    // an entity keeps its handle until it is removed (Handle.h); the handle of the
+    // entity at a position of the vectors below, and the entity of a handle or
+    // nullptr once it is stale
+    Handle getAlgaeHandle(size_t position) const;
+    Handle getCoralHandle(size_t position) const;
+    Handle getScavengerHandle(size_t position) const;
+    const Algae* getAlgae(Handle algae) const;
+    const Coral* getCoral(Handle coral) const;
+    const Scavenger* getScavenger(Handle scavenger) const;
+
     void reset_simulation();
 
     // for testing purposes print out the size of
     void printEntitiesSize() const;
     void printCorals() const;
 
-    std::vector<Algae> get_algae_in_simulation() const;
-    std::vector<Coral> get_coral_in_simulation() const;
-    std::vector<Scavenger> get_scavenger_in_simulation() const;
+    // read-only views, the drawing code reads them every frame so no copies
+    const std::vector<Algae>& get_algae_in_simulation() const;
+    const std::vector<Coral>& get_coral_in_simulation() const;
+    const std::vector<Scavenger>& get_scavenger_in_simulation() const;
     void rotateCoral(Coral& coral);
 
     void rotateCorals();
@@ -65,35 +163,79 @@ private:
     std::vector<Algae> algaeVec;
     std::vector<Coral> coralVec;
     std::vector<Scavenger> scavengerVec;
-    static bool readFileSuccess;
-    static bool algae_birth_allowed;
+    // follow every insertion and removal in the three vectors
+    HandleTable algae_handles;
+    HandleTable coral_handles;
+    HandleTable scavenger_handles;
+    // corals born during updateCorals, moved into coralVec at its end; kept between
+    // updates so its storage is reused
+    std::vector<Coral> coral_births;
+    // where the scavengers born during updateScavengers go, in the order of the
+    // births; they are added once the loop over scavengerVec is over
+    std::vector<S2d> scavenger_births;
+    IdSet coral_IDs;     // of the corals in coralVec, for validateCoralUniqueID
+    int next_coral_ID;   // where generateNewUniqueID starts looking
+    IdSet targeted_IDs;  // of the dead corals a scavenger goes to or eats
+    bool readFileSuccess;
+    // the progress given to start while a file is read, null otherwise
+    const ReadProgress* read_progress;
+    std::streamoff read_size;  // of the file, in bytes
+    unsigned long entries_read;
+    bool read_stopped;  // by read_progress
+    unsigned long static_revision;  // bumped when a dead coral appears or changes
+    Assignment assignment_mode;
+    RandomMode random_mode;
+    stats::Registry last_tick_stats;
+
+    // ages are derived from birth ticks (Lifeform::getAge) and deaths are scheduled
+    // when an entity is added: slot t % size of the wheel holds the algae that die
+    // at update t, marked removed without looking at the others, and counts the
+    // corals and scavengers that may die then, so an update only looks for those
+    // when one is due
+    struct DueDeaths {
+        std::vector<Handle> algae;  // stale once eaten or removed otherwise
+        unsigned corals;
+        unsigned scavengers;
+    };
+    unsigned long tick;
+    std::vector<DueDeaths> death_wheel;  // longer than the longest life
+    DueDeaths& death_slot(unsigned long at);
+    unsigned long next_death_tick(unsigned long limit);  // 0 if none up to limit
+    void schedule_death(const Algae& algae, Handle handle);
+    void schedule_death(const Coral& coral);
+    void schedule_death(const Scavenger& scavenger);
+
+    bool algae_birth_allowed;
     // if true algae is born, stop algae birth, false bydefault
 
     //--------random number generation------
+    unsigned long random_seed;
     std::default_random_engine e;
+    CounterRandom counter_random;  // COUNTER mode
     std::bernoulli_distribution algaeCreationDistribution;
     std::uniform_int_distribution<unsigned> positionDistribution;
     //---------------------------------------
 
-    void readConfigFile(const std::string& filename);
+    bool readConfigFile(const std::string& filename);  // see start
+    bool continue_reading(std::ifstream& file);  // reports the progress
     void readAlgae(std::ifstream& file, int count);
     void readCoral(std::ifstream& file, int count);
     void readScavenger(std::ifstream& file, int count);
     void handleFileReadError(std::ifstream& file, int entryIndex,
                              const std::string& entityType) const;
 
-    bool validateAlgae(const Algae& algae) const;
+    bool validateAlgae(const Algae& algae);
 
-    bool validateCoral(const Coral& coral) const;
+    bool validateCoral(const Coral& coral);
     bool validateCoral_pos(const Coral& coral) const;
-    bool validateCoralUniqueID(const Coral& coral) const;
+    bool validateCoralUniqueID(const Coral& coral);
     bool validateCoralSegmentAngles(const Coral& coral) const;
     bool validateCoralSegmentLengths(const Coral& coral) const;
     bool validateCoralSegmentsSuperposition(const Coral& coral) const;
     bool validateCoral_other_Segments_Superposition(const Coral& coral) const;
     bool validateCoral_self_SegmentsIntersect(const Coral& coral) const;
     bool validateCoral_other_SegmentsIntersect(const Coral& coral) const;
-    bool validateScavenger(const Scavenger& scavenger) const;
+    bool validateScavenger(const Scavenger& scavenger);
     bool validate_rayon_scavenger(const Scavenger& scavenger) const;
     bool validate_sca_corail_cible(const Scavenger& scavenger) const;
 
@@ -105,15 +247,25 @@ private:
     void reportError(const std::string& errorMessage) const;
 
     // file_saving helpers
-    void saveAlgae(std::ofstream& outFile);
-    void saveCorals(std::ofstream& outFile);
-    void saveScavengers(std::ofstream& outFile);
+    static bool saveState(const std::string& filename,
+                          const std::vector<Algae>& algae,
+                          const std::vector<Coral>& corals,
+                          const std::vector<Scavenger>& scavengers,
+                          unsigned long now);
+    static void saveAlgae(std::ofstream& outFile, const std::vector<Algae>& algae,
+                          unsigned long now);
+    static void saveCorals(std::ofstream& outFile, const std::vector<Coral>& corals,
+                           unsigned long now);
+    static void saveScavengers(std::ofstream& outFile,
+                               const std::vector<Scavenger>& scavengers,
+                               unsigned long now);
 
     void clearAllEntities();
 
     void updateAlgae();       // helper method for updateEntities
     void updateCorals();      // helper method for updateEntities
     void updateScavengers();  // helper method for updateEntities
+    void assignTargetsGlobally();  // GLOBAL mode, before the scavengers move
 
     void death_to_algae();   // helper method for updateAlgae, better conception
     void algae_generator();  // helper method for updateAlgae, better conception
@@ -139,12 +291,15 @@ private:
     void print_algae_vector_with_age() const;
     void reproduceCorals();
     void reproduce_Coral_by_division(Coral& coral);
-    Coral generate_coralOffspring(Coral coral);
+    Coral generate_coralOffspring(const Coral& coral);
     bool coral_algae_intersrct(Coral& coral);
 
-    void generateScavengerOffspring(S2d position_Of_baby_scavenger);
+    void generateScavengerOffspring();  // adds the queued scavenger_births
 
     void remove_eaten_corals_from_simulation();
+    // a coral eaten during updateScavengers: its handles go stale at once, it
+    // leaves coralVec at the end of updateScavengers
+    void discard_coral(const Coral& coral);
 
     void scavengerFeedsOnCoral(Scavenger& Scavenger);
     Coral* findNearestDeadCoral(const S2d& position);
@@ -154,6 +309,9 @@ private:
 
     void moveScavenger_toDeadCoral(Scavenger& scavenger, Coral* coral);
     Coral* findCoralById(unsigned int coralId);
+    Coral* findCoral(Handle coral);  // nullptr if stale
+    // the handle of the target of a scavenger given only its ID (read from a file)
+    void resolve_target(Scavenger& scavenger);
 
     void printScavengers() const;
 };
@@ -10,9 +10,13 @@
  *              Key functionalities include:
  *              - Starting and stopping the simulation
  *              - Single-step execution
- *              - Opening and saving files
+ *              - Opening and saving files in the background
  *              - Dynamically updating display of entity counts
  *              - Managing algae reproduction control via a checkbox
+ *              - Fast-forwarding (x1, x10, x100, max updates per frame)
+ *              - Recording a trace of the updates (key 't')
+ *              - Sparklines of the recent metrics, written to CSV with key 'm'
+ *              - Going back to a recent update with the timeline slider
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -21,6 +25,22 @@
 
 #include "SimulationWindow.h"
 
+#include <chrono>
+#include <cstdio>    // for std::snprintf
+#include <filesystem>
+#include <iterator>  // for std::size
+#include <memory>
+
+#include "Trace.h"
+
+// updates per displayed frame, 0 means as many as fit in the frame budget
+const unsigned SimulationWindow::speed_multipliers[] = {1, 10, 100, 0};
+
+namespace {
+constexpr size_t sparkline_samples(300);  // most recent updates shown
+constexpr size_t megabyte(size_t(1) << 20);
+}
+
 SimulationWindow::SimulationWindow(Simulation& simulation_)
     : simulation(simulation_),
       mise_a_jour_count(0),
@@ -30,6 +50,7 @@ SimulationWindow::SimulationWindow(Simulation& simulation_)
       mainBox(Gtk::Orientation::HORIZONTAL, 0),
       sideBox(Gtk::Orientation::VERTICAL, 0),
       buttonsBox(Gtk::Orientation::VERTICAL, 2),
+      viewBox(Gtk::Orientation::VERTICAL, 0),
       drawingBox(Gtk::Orientation::HORIZONTAL, 0),
       infoBox(Gtk::Orientation::VERTICAL, 0),
       mise_a_jour_Box(Gtk::Orientation::HORIZONTAL, 20),
@@ -41,7 +62,10 @@ SimulationWindow::SimulationWindow(Simulation& simulation_)
       saveButton("Save"),
       openButton("Open"),
       exitButton("Exit"),
+      speedButton("Vitesse: x1"),
       algaeBirthCheckbox("Naissance Algues", false),
+      loadBox(Gtk::Orientation::VERTICAL, 2),
+      cancelLoadButton("Annuler"),
       general_Label("General"),
       infoLabel("Info: nombre de..."),
       mise_a_jour_Label("mise à jour:"),
@@ -53,7 +77,25 @@ SimulationWindow::SimulationWindow(Simulation& simulation_)
       algaeCountLabel(std::to_string(Algae_count)),
       coralCountLabel(std::to_string(coral_count)),
       scavengerCountLabel(std::to_string(scavenger_count)),
-      tick_interval(100) {
+      statsTitleLabel("Performance (dernière mise à jour):"),
+      statsLabel(),
+      metrics(),
+      algaeSparkline("algues", Colors::Green()),
+      coralSparkline("coraux vivants", Colors::Blue()),
+      scavengerSparkline("charognards", Colors::Red()),
+      tickSparkline("mise à jour (ms)", Colors::Black()),
+      timelineBox(Gtk::Orientation::HORIZONTAL, 6),
+      timelineScale(Gtk::Orientation::HORIZONTAL),
+      timelineBudgetLabel("mémoire de l'historique (Mo):"),
+      timeline(),
+      past(),
+      showing_past(false),
+      timeline_moved_by_code(false),
+      tick_interval(100),
+      frame_budget(80),
+      speed_index(0),
+      traces_written(0),
+      metrics_files_written(0) {
     set_title("Micro_Reef");
     set_child(mainBox);
 
@@ -70,7 +112,9 @@ SimulationWindow::SimulationWindow(Simulation& simulation_)
     scavengerCountLabel.set_xalign(1.0);
     // Main Box setup
     mainBox.append(sideBox);
-    mainBox.append(drawingBox);
+    mainBox.append(viewBox);
+    viewBox.append(drawingBox);
+    viewBox.append(timelineBox);
 
     // Drawing Box setup
     drawingBox.set_size_request(500, 500);
@@ -89,8 +133,17 @@ SimulationWindow::SimulationWindow(Simulation& simulation_)
     buttonsBox.append(saveButton);
     buttonsBox.append(startButton);
     buttonsBox.append(stepButton);
+    buttonsBox.append(speedButton);
     buttonsBox.append(algaeBirthCheckbox);
 
+    loadProgressBar.set_show_text(true);
+    loadBox.append(loadProgressBar);
+    loadBox.append(cancelLoadButton);
+    loadBox.set_visible(false);
+    buttonsBox.append(loadBox);
+    saveStatusLabel.set_xalign(0.0);
+    buttonsBox.append(saveStatusLabel);
+
     // Info Box setup
     infoFrame.set_child(infoBox);
     sideBox.append(infoFrame);
@@ -109,6 +162,32 @@ SimulationWindow::SimulationWindow(Simulation& simulation_)
     infoBox.append(coralBox);
     infoBox.append(scavengerBox);
 
+    statsTitleLabel.set_xalign(0.0);
+    statsTitleLabel.set_margin_top(10);
+    statsLabel.set_xalign(0.0);
+    infoBox.append(statsTitleLabel);
+    infoBox.append(statsLabel);
+
+    for (Sparkline* sparkline :
+         {&algaeSparkline, &coralSparkline, &scavengerSparkline, &tickSparkline}) {
+        sparkline->set_margin_top(4);
+        infoBox.append(*sparkline);
+    }
+
+    // Timeline under the drawing
+    timelineBox.set_margin(4);
+    timelineScale.set_digits(0);
+    timelineScale.set_draw_value(false);
+    timelineScale.set_increments(1, 100);
+    timelineScale.set_hexpand(true);
+    timelineBudgetSpin.set_range(1, 65536);
+    timelineBudgetSpin.set_increments(16, 256);
+    timelineBudgetSpin.set_value(timeline.getBudget() / megabyte);
+    timelineBox.append(timelineScale);
+    timelineBox.append(timelineLabel);
+    timelineBox.append(timelineBudgetLabel);
+    timelineBox.append(timelineBudgetSpin);
+
     startButton.signal_toggled().connect(
         sigc::mem_fun(*this, &SimulationWindow::onStartClicked));
 
@@ -127,6 +206,22 @@ SimulationWindow::SimulationWindow(Simulation& simulation_)
     algaeBirthCheckbox.signal_toggled().connect(
         sigc::mem_fun(*this, &SimulationWindow::onAlgaeBirthChecked));
 
+    speedButton.signal_clicked().connect(
+        sigc::mem_fun(*this, &SimulationWindow::onSpeedClicked));
+
+    cancelLoadButton.signal_clicked().connect(
+        sigc::mem_fun(*this, &SimulationWindow::onCancelLoadClicked));
+
+    loadDispatcher.connect(sigc::mem_fun(*this, &SimulationWindow::onLoadProgress));
+    saveDispatcher.connect(sigc::mem_fun(*this, &SimulationWindow::onSaveDone));
+
+    timelineScale.signal_value_changed().connect(
+        sigc::mem_fun(*this, &SimulationWindow::onTimelineMoved));
+    timelineBudgetSpin.signal_value_changed().connect(
+        sigc::mem_fun(*this, &SimulationWindow::onTimelineBudgetChanged));
+
+    timeline.record(simulation);  // the state read, the first update to go back to
+
     updateCounts();
     drawingArea.updateSimulationData(simulation);
 
@@ -137,6 +232,9 @@ SimulationWindow::SimulationWindow(Simulation& simulation_)
 }
 
 SimulationWindow::~SimulationWindow() {
+    if (trace::is_enabled()) {
+        toggleTrace();  // writes what was recorded
+    }
     // garbage collection with Simulation& simulation;
     delete &simulation;
     // std::cout << "SimulationWindow deleted" << std::endl;
@@ -156,6 +254,47 @@ void SimulationWindow::updateCounts() {
     algaeCountLabel.set_text(std::to_string(simulation.getAlgaeCount()));
     coralCountLabel.set_text(std::to_string(simulation.getCoralCount()));
     scavengerCountLabel.set_text(std::to_string(simulation.getScavengerCount()));
+    updateStats();
+    updateSparklines();
+    updateTimeline();
+}
+
+void SimulationWindow::updateSparklines() {
+    metrics.recent(MetricsRecorder::ALGAE, sparkline_samples,
+                   algaeSparkline.getValues());
+    metrics.recent(MetricsRecorder::LIVE_CORALS, sparkline_samples,
+                   coralSparkline.getValues());
+    metrics.recent(MetricsRecorder::SCAVENGERS, sparkline_samples,
+                   scavengerSparkline.getValues());
+    metrics.recent(MetricsRecorder::TICK_MS, sparkline_samples,
+                   tickSparkline.getValues());
+    for (Sparkline* sparkline :
+         {&algaeSparkline, &coralSparkline, &scavengerSparkline, &tickSparkline}) {
+        sparkline->queue_draw();
+    }
+}
+
+void SimulationWindow::updateStats() {
+    if (!stats::enabled) {
+        statsLabel.set_text("désactivé (compiler avec MICROREEF_STATS)");
+        return;
+    }
+    const stats::Registry& last = simulation.getLastTickStats();
+    std::string text;
+    char line[96];
+    for (int p = 0; p < stats::PHASE_COUNT; ++p) {
+        std::snprintf(line, sizeof(line), "%s: %.3f ms (%llu)\n",
+                      stats::phase_name(stats::Phase(p)), last.phase_ns[p] / 1e6,
+                      last.phase_calls[p]);
+        text += line;
+    }
+    for (int c = 0; c < stats::COUNTER_COUNT; ++c) {
+        std::snprintf(line, sizeof(line), "%s: %llu\n",
+                      stats::counter_name(stats::Counter(c)), last.counters[c]);
+        text += line;
+    }
+    text.pop_back();  // last newline
+    statsLabel.set_text(text);
 }
 
 void SimulationWindow::Reset_INFO() {
@@ -167,10 +306,12 @@ void SimulationWindow::Reset_INFO() {
     algaeCountLabel.set_text(std::to_string(Algae_count));
     coralCountLabel.set_text(std::to_string(coral_count));
     scavengerCountLabel.set_text(std::to_string(scavenger_count));
+    metrics.clear();
 }
 
 void SimulationWindow::onStartClicked() {
     if (startButton.get_active()) {
+        resumeFromPast();
         m_Connection = Glib::signal_timeout().connect(
             sigc::mem_fun(*this, &SimulationWindow::onTimeout), tick_interval);
         startButton.set_label("Stop");
@@ -182,9 +323,9 @@ void SimulationWindow::onStartClicked() {
 
 void SimulationWindow::onStepClicked() {
     if (!startButton.get_active()) {
-        mise_a_jour_count++;
+        resumeFromPast();
+        runTickBatch(1);
         mise_a_jour_Count.set_text(std::to_string(mise_a_jour_count));
-        simulation.updateEntities();
         updateCounts();
         drawingArea.updateSimulationData(simulation);  // Update DrawingArea
     } else {
@@ -268,12 +409,21 @@ void SimulationWindow::onAlgaeBirthChecked() {
     simulation.toggleAlgaeBirthAllowed();
 }
 
+void SimulationWindow::onSpeedClicked() {
+    speed_index = (speed_index + 1) % std::size(speed_multipliers);
+    unsigned multiplier = speed_multipliers[speed_index];
+    if (multiplier == 0) {
+        speedButton.set_label("Vitesse: max");
+    } else {
+        speedButton.set_label("Vitesse: x" + std::to_string(multiplier));
+    }
+}
+
 bool SimulationWindow::onTimeout() {
     if (startButton.get_active()) {
-        mise_a_jour_count++;
+        runTickBatch(speed_multipliers[speed_index]);  // Update the simulation first
         mise_a_jour_Count.set_text(std::to_string(mise_a_jour_count));
-        simulation.updateEntities();  // Update the simulation first
-        updateCounts();               // Then update the counts
+        updateCounts();  // Then update the counts
         drawingArea.updateSimulationData(
             simulation);  // Finally, update the drawing area
         return true;      // Continue the timeout
@@ -281,6 +431,60 @@ bool SimulationWindow::onTimeout() {
     return false;  // Stop the timeout
 }
 
+unsigned SimulationWindow::runTickBatch(unsigned multiplier) {
+    // run up to multiplier updates (0 = unbounded) but give the hand back to gtk
+    // once the frame budget is spent so the window stays responsive, at least one
+    // update is always done so x1 behaves exactly like before
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::milliseconds(frame_budget);
+    unsigned done = 0;
+    do {
+        auto tick_start = std::chrono::steady_clock::now();
+        simulation.updateEntities();
+        timeline.record(simulation);
+        ++done;
+        std::chrono::duration<double, std::milli> tick_time =
+            std::chrono::steady_clock::now() - tick_start;
+        metrics.record(simulation, mise_a_jour_count + done, tick_time.count());
+    } while ((multiplier == 0 || done < multiplier) &&
+             std::chrono::steady_clock::now() - start < budget);
+
+    mise_a_jour_count += done;  // one per update actually run
+    return done;
+}
+
+void SimulationWindow::toggleMetricsFile() {
+    if (metrics.isOpen()) {
+        metrics.close();
+        std::cout << "metrics file closed" << std::endl;
+        return;
+    }
+    std::string filename =
+        "metrics_" + std::to_string(++metrics_files_written) + ".csv";
+    if (metrics.open(filename)) {
+        std::cout << "writing metrics to " << filename << std::endl;
+    } else {
+        std::cerr << "Error: Unable to open file " << filename << " for writing."
+                  << std::endl;
+    }
+}
+
+void SimulationWindow::toggleTrace() {
+    if (!trace::is_enabled()) {
+        trace::discard();  // events left from an older trace
+        trace::set_enabled(true);
+        std::cout << "trace started" << std::endl;
+        return;
+    }
+    trace::set_enabled(false);
+    std::string filename = "trace_" + std::to_string(++traces_written) + ".json";
+    if (trace::flush(filename)) {
+        std::cout << "trace written to " << filename << std::endl;
+    } else {
+        std::cerr << "Error: Unable to write the trace to " << filename << std::endl;
+    }
+}
+
 bool SimulationWindow::handleKeyPress(guint keyval, guint, Gdk::ModifierType state) {
     switch (gdk_keyval_to_unicode(keyval)) {
         case 's':
@@ -293,6 +497,24 @@ bool SimulationWindow::handleKeyPress(guint keyval, guint, Gdk::ModifierType sta
         case '1':
             onStepClicked();
             return true;
+        case 'f':  // fast-forward: cycle x1, x10, x100, max
+            onSpeedClicked();
+            return true;
+        case '+':  // zoom and reset the view, the mouse wheel and drag also work
+            drawingArea.zoom_by(1.25);
+            return true;
+        case '-':
+            drawingArea.zoom_by(0.8);
+            return true;
+        case '0':
+            drawingArea.reset_view();
+            return true;
+        case 't':
+            toggleTrace();
+            return true;
+        case 'm':
+            toggleMetricsFile();
+            return true;
         case 'Q':  // pas dans le pdf du projet mais pour quitter
             hide();
             return true;
@@ -309,13 +531,15 @@ void SimulationWindow::handleFileDialogResponse(int response_id,
         case Gtk::ResponseType::OK: {
             // Notice that this is a std::string, not a Glib::ustring.
             auto filename = dialog->get_file()->get_path();
-            std::ifstream file(filename);
             std::cout << "File selected: " << filename << std::endl;
 
-            Reset_INFO();
-            simulation.start(filename);
-            updateCounts();
-            drawingArea.queue_draw();  // Force the drawing area to redraw
+            // read into a new simulation meanwhile the current one keeps running,
+            // onLoadProgress swaps it in
+            loadProgressBar.set_fraction(0.0);
+            loadProgressBar.set_text("Lecture du fichier...");
+            loadBox.set_visible(true);
+            openButton.set_sensitive(false);
+            loader.start(filename, [this] { loadDispatcher.emit(); });
             break;
         }
         case Gtk::ResponseType::CANCEL: {
@@ -330,6 +554,122 @@ void SimulationWindow::handleFileDialogResponse(int response_id,
     delete dialog;
 }
 
+void SimulationWindow::onLoadProgress() {
+    if (!loader.isBusy()) {
+        return;  // left from a reading already taken
+    }
+    if (!loader.isDone()) {
+        loadProgressBar.set_fraction(loader.getProgress());
+        return;
+    }
+    std::unique_ptr<Simulation> loaded = loader.take();
+    loadBox.set_visible(false);
+    openButton.set_sensitive(true);
+    if (!loaded) {
+        std::cout << "File not loaded." << std::endl;  // cancelled or cannot open
+        return;
+    }
+    // the settings of the window apply to the new file too
+    loaded->setAlgaeBirthAllowed(algaeBirthCheckbox.get_active());
+    loaded->setAssignment(simulation.getAssignment());
+    simulation.replaceWith(std::move(*loaded));
+    showing_past = false;
+    timeline.clear();
+    timeline.record(simulation);
+
+    Reset_INFO();
+    updateCounts();
+    drawingArea.updateSimulationData(simulation);  // Force the drawing area to redraw
+}
+
+void SimulationWindow::updateTimeline() {
+    unsigned long first = timeline.getFirstTick();
+    unsigned long last = timeline.getLastTick();
+    timeline_moved_by_code = true;
+    timelineScale.set_sensitive(last > first);
+    if (last > first) {
+        timelineScale.set_range(first, last);
+    }
+    if (!showing_past) {
+        timelineScale.set_value(last);
+    }
+    timeline_moved_by_code = false;
+
+    char text[64];
+    std::snprintf(text, sizeof(text), "%lu / %lu (%.1f Mo)",
+                  showing_past ? past.getTick() : last, last,
+                  double(timeline.getMemoryUsed()) / megabyte);
+    timelineLabel.set_text(text);
+}
+
+void SimulationWindow::onTimelineMoved() {
+    if (timeline_moved_by_code) {
+        return;
+    }
+    auto tick = static_cast<unsigned long>(timelineScale.get_value() + 0.5);
+    if (tick >= timeline.getLastTick()) {
+        showLive();
+        return;
+    }
+    if (!timeline.seek(tick)) {
+        return;  // dropped from the timeline meanwhile
+    }
+    startButton.set_active(false);  // looking at the past pauses the simulation
+    past.restore(timeline.getState());
+    showing_past = true;
+    mise_a_jour_Count.set_text(std::to_string(tick));
+    algaeCountLabel.set_text(std::to_string(past.getAlgaeCount()));
+    coralCountLabel.set_text(std::to_string(past.getCoralCount()));
+    scavengerCountLabel.set_text(std::to_string(past.getScavengerCount()));
+    updateTimeline();
+    drawingArea.updateSimulationData(past);
+}
+
+void SimulationWindow::showLive() {
+    if (!showing_past) {
+        return;
+    }
+    showing_past = false;
+    mise_a_jour_Count.set_text(std::to_string(mise_a_jour_count));
+    updateCounts();
+    drawingArea.updateSimulationData(simulation);
+}
+
+void SimulationWindow::resumeFromPast() {
+    if (!showing_past) {
+        return;
+    }
+    // the updates after the one shown are forgotten by the next timeline.record
+    simulation.restore(timeline.getState());
+    mise_a_jour_count = simulation.getTick();
+    showing_past = false;
+    drawingArea.updateSimulationData(simulation);
+}
+
+void SimulationWindow::onTimelineBudgetChanged() {
+    timeline.setBudget(static_cast<size_t>(timelineBudgetSpin.get_value()) * megabyte);
+    updateTimeline();
+}
+
+void SimulationWindow::onCancelLoadClicked() {
+    loader.cancel();  // onLoadProgress cleans up once the worker stops
+    loadProgressBar.set_text("Annulation...");
+}
+
+void SimulationWindow::onSaveDone() {
+    if (!saver.isBusy() || !saver.isDone()) {
+        return;  // already reported, or left from an earlier save
+    }
+    std::string name =
+        std::filesystem::path(saver.getFilename()).filename().string();
+    if (saver.finish()) {
+        std::cout << "File created: " << saver.getFilename() << std::endl;
+        saveStatusLabel.set_text("Sauvegardé: " + name);
+    } else {
+        saveStatusLabel.set_text("Échec de la sauvegarde: " + name);
+    }
+}
+
 void SimulationWindow::handleSaveDialogResponse(int response_id,
                                                 Gtk::FileChooserDialog* dialog) {
     // voir la serie
@@ -343,9 +683,22 @@ void SimulationWindow::handleSaveDialogResponse(int response_id,
             if (filename.substr(filename.size() - 4) != ".txt") {
                 filename += ".txt";
             }
-            simulation.saveSimulation(filename);
-            std::cout << "File created: " << filename << std::endl;
-
+            std::string previous =
+                std::filesystem::path(saver.getFilename()).filename().string();
+            if (saver.isBusy() && !saver.isDone()) {
+                // one save at a time, the file is not written
+                saveStatusLabel.set_text("Sauvegarde en cours: " + previous +
+                                         ", réessayez ensuite");
+                break;
+            }
+            // the entities are copied now and written while the simulation goes on;
+            // a previous save not reported yet is reported here if it failed
+            if (saver.start(simulation, filename, [this] { saveDispatcher.emit(); })) {
+                saveStatusLabel.set_text("Sauvegarde...");
+            } else {
+                saveStatusLabel.set_text("Échec de la sauvegarde: " + previous +
+                                         ", sauvegarde...");
+            }
             break;
         }
         case Gtk::ResponseType::CANCEL: {
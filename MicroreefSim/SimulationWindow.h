@@ -11,8 +11,20 @@
  *              Widgets include:
  *              - Start/Stop simulation
  *              - Step through simulation
- *              - Open and save simulation states
+ *              - Open and save simulation states, a file is read in the background
+ *                with a progress bar and can be cancelled (FileLoader.h), a save is
+ *                written in the background while the simulation goes on
+ *                (FileSaver.h)
  *              - Adjust simulation parameters such as algae birth
+ *              - Fast-forward several updates per displayed frame
+ *              - Time per phase of the last update (when built with MICROREEF_STATS)
+ *              - Key 't' starts a trace and writes it to trace_N.json when pressed
+ *                again (see Trace.h)
+ *              - Sparklines of the recent populations and update time, key 'm'
+ *                starts or stops writing every sample to metrics_N.csv
+ *              - A timeline slider over the recent updates (Timeline.h): moving it
+ *                pauses the simulation and shows the update chosen, Start or Step
+ *                go on from there; the memory it may use is set in megabytes
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -33,6 +45,9 @@
 #include <gtkmm/filechooserdialog.h>
 #include <gtkmm/frame.h>
 #include <gtkmm/label.h>
+#include <gtkmm/progressbar.h>
+#include <gtkmm/scale.h>
+#include <gtkmm/spinbutton.h>
 #include <gtkmm/togglebutton.h>
 #include <gtkmm/window.h>
 //-----
@@ -40,13 +55,20 @@
 #include <fstream>
 
 #include "DrawingArea.h"
+#include "FileLoader.h"
+#include "FileSaver.h"
+#include "MetricsRecorder.h"
 #include "Simulation.h"
+#include "Sparkline.h"
+#include "Timeline.h"
 
 class SimulationWindow : public Gtk::Window {
 public:
     SimulationWindow(Simulation& simulation_);
     virtual ~SimulationWindow();
     void updateCounts();
+    void updateStats();
+    void updateSparklines();
     void Reset_INFO();
 
 protected:
@@ -57,7 +79,7 @@ protected:
     unsigned coral_count;
     unsigned scavenger_count;
 
-    Gtk::Box mainBox, sideBox, buttonsBox, drawingBox, infoBox;
+    Gtk::Box mainBox, sideBox, buttonsBox, viewBox, drawingBox, infoBox;
     Gtk::Box mise_a_jour_Box, algaeBox, coralBox, scavengerBox;
 
     Gtk::Button stepButton;
@@ -65,8 +87,14 @@ protected:
     Gtk::Button saveButton;
     Gtk::Button openButton;
     Gtk::Button exitButton;
+    Gtk::Button speedButton;
     Gtk::CheckButton algaeBirthCheckbox;
 
+    Gtk::Box loadBox;  // shown while a file is read
+    Gtk::ProgressBar loadProgressBar;
+    Gtk::Button cancelLoadButton;
+    Gtk::Label saveStatusLabel;
+
     Gtk::Label general_Label, infoLabel;
     Gtk::Label mise_a_jour_Label, algaeLabel, coralLabel, scavengerLabel;
 
@@ -77,6 +105,22 @@ protected:
     Gtk::Label mise_a_jour_Count, algaeCountLabel, coralCountLabel,
         scavengerCountLabel;
 
+    Gtk::Label statsTitleLabel, statsLabel;  // per phase timings, see Stats.h
+
+    MetricsRecorder metrics;
+    Sparkline algaeSparkline, coralSparkline, scavengerSparkline, tickSparkline;
+
+    Gtk::Box timelineBox;  // under the drawing
+    Gtk::Scale timelineScale;
+    Gtk::Label timelineLabel, timelineBudgetLabel;
+    Gtk::SpinButton timelineBudgetSpin;  // in megabytes
+    Timeline timeline;
+    // the update chosen on the timeline, drawn instead of simulation while
+    // showing_past
+    Simulation past;
+    bool showing_past;
+    bool timeline_moved_by_code;  // the slider signal is ours, not the user's
+
     void setup_label_count_pair(Gtk::Box& box, Gtk::Label& label, Gtk::Label& count);
 
     void onStepClicked();
@@ -85,8 +129,20 @@ protected:
     void onOpenClicked();
     void onExitClicked();
     void onAlgaeBirthChecked();
+    void onSpeedClicked();
+    void toggleTrace();
+    void toggleMetricsFile();
+    void onLoadProgress();  // from the loader thread, through loadDispatcher
+    void onCancelLoadClicked();
+    void onSaveDone();  // from the saver thread, through saveDispatcher
+    void onTimelineMoved();
+    void onTimelineBudgetChanged();
+    void updateTimeline();  // range of the slider and memory used
+    void showLive();
+    void resumeFromPast();  // simulation goes back to the update shown
 
     bool onTimeout();
+    unsigned runTickBatch(unsigned multiplier);  // returns the number of ticks run
     bool handleKeyPress(guint keyval, guint keycode, Gdk::ModifierType state);
 
     void handleFileDialogResponse(int response_id, Gtk::FileChooserDialog* dialog);
@@ -95,6 +151,17 @@ protected:
 private:
     sigc::connection m_Connection;
     int tick_interval;  // in milliseconds
+    int frame_budget;   // in milliseconds, time spent on updates per frame
+    size_t speed_index;  // index in speed_multipliers
+    static const unsigned speed_multipliers[];  // 0 means as fast as possible
+    unsigned traces_written;
+    unsigned metrics_files_written;
+    // declared before the loader and saver, whose workers may still emit them
+    // while joined
+    Glib::Dispatcher loadDispatcher;
+    Glib::Dispatcher saveDispatcher;
+    FileLoader loader;
+    FileSaver saver;
 };
 
 #endif  // SIMULATION_WINDOW_H
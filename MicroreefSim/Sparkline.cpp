@@ -0,0 +1,70 @@
+/**
+ * File: Sparkline.cpp
+ * --------------------
+ * Description: Implements the Sparkline class from Sparkline.h.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "Sparkline.h"
+
+#include <algorithm>
+#include <cstdio>  // for std::snprintf
+
+namespace {
+constexpr int sparkline_width(160);
+constexpr int sparkline_height(28);
+constexpr double title_height(10);  // space above the line for the title
+}  // namespace
+
+Sparkline::Sparkline(const std::string& title_, const Color& color_)
+    : title(title_), color(color_) {
+    set_content_width(sparkline_width);
+    set_content_height(sparkline_height);
+    set_draw_func(sigc::mem_fun(*this, &Sparkline::on_draw));
+}
+
+Sparkline::~Sparkline() {}
+
+void Sparkline::setValues(const std::vector<double>& values_) {
+    values = values_;
+    queue_draw();
+}
+
+std::vector<double>& Sparkline::getValues() {
+    return values;
+}
+
+void Sparkline::on_draw(const Cairo::RefPtr<Cairo::Context>& cr, int width,
+                        int height) {
+    cr->set_font_size(9);
+    char text[64];
+    std::snprintf(text, sizeof(text), "%s: %.6g", title.c_str(),
+                  values.empty() ? 0.0 : values.back());
+    cr->set_source_rgb(0.0, 0.0, 0.0);
+    cr->move_to(0, title_height - 1);
+    cr->show_text(text);
+
+    if (values.size() < 2) {
+        return;
+    }
+    auto [lowest, highest] = std::minmax_element(values.begin(), values.end());
+    double range = *highest - *lowest;
+    double plot_height = height - title_height - 2;
+    double step = double(width - 1) / (values.size() - 1);
+
+    beginStyle(cr, color, 1.0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        // a constant series is drawn in the middle
+        double level = range > 0 ? (values[i] - *lowest) / range : 0.5;
+        double y = height - 1 - level * plot_height;
+        if (i == 0) {
+            cr->move_to(0, y);
+        } else {
+            cr->line_to(i * step, y);
+        }
+    }
+    strokeStyle(cr);
+}
@@ -0,0 +1,39 @@
+/**
+ * File: Sparkline.h
+ * ------------------
+ * Description: Defines the Sparkline class, a small GenericDrawing widget that
+ *              plots a series of values as a line scaled between its minimum and
+ *              maximum, with the last value written next to it. It is used by the
+ *              SimulationWindow to show the recent history kept by MetricsRecorder.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#include <string>
+#include <vector>
+
+#include "GenericDrawing.h"
+
+class Sparkline : public GenericDrawing {
+public:
+    Sparkline(const std::string& title_, const Color& color_);
+    virtual ~Sparkline();
+
+    // values oldest first, redraws the widget
+    void setValues(const std::vector<double>& values_);
+    std::vector<double>& getValues();  // to fill in place, then call queue_draw
+
+private:
+    std::string title;
+    Color color;
+    std::vector<double> values;
+
+    void on_draw(const Cairo::RefPtr<Cairo::Context>& cr, int width, int height);
+};
+
+#endif  // SPARKLINE_H
@@ -0,0 +1,83 @@
+/**
+ * File: Stats.cpp
+ * ----------------
+ * Description: Implements the helpers of Stats.h and, when MICROREEF_STATS is
+ *              defined, replaces the global operator new and delete so that every
+ *              allocation is counted in the registry of the allocating thread.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "Stats.h"
+
+#include <cstdlib>
+#include <new>
+
+const char* stats::phase_name(Phase phase) {
+    switch (phase) {
+        case UPDATE_ALGAE:
+            return "algues";
+        case UPDATE_CORALS:
+            return "coraux";
+        case UPDATE_SCAVENGERS:
+            return "charognards";
+        case CORAL_INTERSECTION:
+            return "intersections";
+        case SWEEPING_PASS:
+            return "balayage";
+        case CONSUME_ALGAE:
+            return "algues mangees";
+        case NEAREST_DEAD_CORAL:
+            return "corail mort proche";
+        case ASSIGN_TARGETS:
+            return "affectation";
+        default:
+            return "?";
+    }
+}
+
+const char* stats::counter_name(Counter counter) {
+    switch (counter) {
+        case SEGMENT_PAIR_TESTS:
+            return "tests segments";
+        case TRIG_CALLS:
+            return "appels trigo";
+        case ALLOCATIONS:
+            return "allocations";
+        default:
+            return "?";
+    }
+}
+
+stats::Registry stats::difference(const Registry& after, const Registry& before) {
+    Registry delta = {};
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+        delta.phase_ns[i] = after.phase_ns[i] - before.phase_ns[i];
+        delta.phase_calls[i] = after.phase_calls[i] - before.phase_calls[i];
+    }
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        delta.counters[i] = after.counters[i] - before.counters[i];
+    }
+    return delta;
+}
+
+#ifdef MICROREEF_STATS
+// new[] and delete[] forward to these by default, so they are counted too
+void* operator new(std::size_t size) {
+    ++stats::thread_registry.counters[stats::ALLOCATIONS];
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+#endif
@@ -0,0 +1,82 @@
+/**
+ * File: Stats.h
+ * --------------
+ * Description: Lightweight instrumentation of the simulation hot paths: scoped
+ *              timers around the update phases and counters of the expensive
+ *              operations (segment pair tests, trigonometric calls, allocations).
+ *              Everything is recorded per thread in a plain registry, so the
+ *              thread running the simulation never waits for another one.
+ *
+ *              The instrumentation exists only when MICROREEF_STATS is defined (see
+ *              the Makefile). Otherwise STATS_SCOPE and STATS_ADD expand to nothing
+ *              and the registry stays zero, so it costs nothing.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <chrono>
+
+namespace stats {
+enum Phase {
+    UPDATE_ALGAE,
+    UPDATE_CORALS,
+    UPDATE_SCAVENGERS,
+    CORAL_INTERSECTION,  // checkCoralIntersection
+    SWEEPING_PASS,       // sweepingPassDetected
+    CONSUME_ALGAE,       // checkAndConsumeAlgae
+    NEAREST_DEAD_CORAL,  // findNearestDeadCoral
+    ASSIGN_TARGETS,      // assignTargetsGlobally
+    PHASE_COUNT
+};
+enum Counter { SEGMENT_PAIR_TESTS, TRIG_CALLS, ALLOCATIONS, COUNTER_COUNT };
+
+// plain data and constant initialized, so it can be used from operator new
+struct Registry {
+    unsigned long long phase_ns[PHASE_COUNT];     // time spent, phases nest
+    unsigned long long phase_calls[PHASE_COUNT];  // times entered
+    unsigned long long counters[COUNTER_COUNT];
+};
+
+const char* phase_name(Phase phase);
+const char* counter_name(Counter counter);
+Registry difference(const Registry& after, const Registry& before);
+
+#ifdef MICROREEF_STATS
+constexpr bool enabled = true;
+
+inline thread_local Registry thread_registry = {};
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Phase phase_)
+        : phase(phase_), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        thread_registry.phase_ns[phase] +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        ++thread_registry.phase_calls[phase];
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Phase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define STATS_SCOPE(phase) stats::ScopedTimer stats_scope_timer(stats::phase)
+#define STATS_ADD(counter, n) (stats::thread_registry.counters[stats::counter] += (n))
+#else
+constexpr bool enabled = false;
+
+#define STATS_SCOPE(phase) ((void)0)
+#define STATS_ADD(counter, n) ((void)0)
+#endif
+}  // namespace stats
+
+#endif  // STATS_H
@@ -0,0 +1,180 @@
+/**
+ * File: Timeline.cpp
+ * -------------------
+ * Description: Implements the Timeline class from Timeline.h.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "Timeline.h"
+
+#include <algorithm>
+
+#include "Trace.h"
+
+Timeline::Timeline(size_t budget_, unsigned keyframe_interval_)
+    : budget(budget_),
+      memory_used(0),
+      keyframe_interval(std::max(keyframe_interval_, 1u)),
+      frames_since_keyframe(0),
+      resume{{}, {}, {}, 0, {}, 0, Simulation::ENGINE, 1},
+      state{{}, {}, {}, 0, {}, 0, Simulation::ENGINE, 1},
+      state_memory(0),
+      positioned(false) {}
+
+void Timeline::setBudget(size_t bytes) {
+    budget = bytes;
+    size_t working = working_memory();
+    while (memory_used + working > budget && drop_oldest()) {
+    }
+}
+
+size_t Timeline::getBudget() const {
+    return budget;
+}
+
+size_t Timeline::getMemoryUsed() const {
+    return memory_used + working_memory();
+}
+
+void Timeline::record(const Simulation& simulation) {
+    TRACE_SCOPE("Timeline::record");
+    unsigned long tick = simulation.getTick();
+    if (!frames.empty() && tick <= frames.back().tick) {
+        // the run went on from an earlier state
+        if (tick == 0) {
+            clear();
+        } else {
+            forget_after(tick - 1);
+        }
+    }
+    bool keyframe = frames_since_keyframe == 0;
+    if (keyframe) {
+        encoder.keyframe(simulation, frame);
+    } else {
+        encoder.delta(simulation, frame);
+    }
+    simulation.takeResumeState(resume);
+    frames.push_back({tick, keyframe, frame, resume.random_engine,
+                      resume.next_coral_ID, resume.random_mode, resume.random_seed});
+    memory_used += memory_of(frames.back());
+    frames_since_keyframe = (frames_since_keyframe + 1) % keyframe_interval;
+
+    size_t working = working_memory();
+    while (memory_used + working > budget && drop_oldest()) {
+    }
+    if (memory_used + working > budget) {
+        frames_since_keyframe = 0;  // so that the only keyframe left can go next
+    }
+}
+
+void Timeline::clear() {
+    frames.clear();
+    memory_used = 0;
+    frames_since_keyframe = 0;
+    positioned = false;
+}
+
+bool Timeline::empty() const {
+    return frames.empty();
+}
+
+unsigned long Timeline::getFirstTick() const {
+    return frames.empty() ? 0 : frames.front().tick;
+}
+
+unsigned long Timeline::getLastTick() const {
+    return frames.empty() ? 0 : frames.back().tick;
+}
+
+bool Timeline::seek(unsigned long tick) {
+    TRACE_SCOPE("Timeline::seek");
+    size_t after = index_after(tick);
+    if (after == 0 || frames[after - 1].tick != tick) {
+        return false;
+    }
+    size_t target = after - 1;
+    size_t keyframe = target;
+    while (!frames[keyframe].keyframe) {
+        --keyframe;
+    }
+    size_t from = keyframe;
+    if (positioned) {
+        size_t current = index_after(state.tick);
+        if (current > keyframe && current <= target + 1 &&
+            frames[current - 1].tick == state.tick) {
+            from = current;  // forward from the state shown, no keyframe between
+        }
+    }
+    positioned = false;
+    for (size_t i = from; i <= target; ++i) {
+        const trajectory::Bytes& data = frames[i].data;
+        bool applied =
+            frames[i].keyframe
+                ? trajectory::applyKeyframe(data.data(), data.size(), state)
+                : trajectory::applyDelta(data.data(), data.size(), state);
+        if (!applied) {
+            state_memory = trajectory::memoryUsed(state);
+            return false;
+        }
+    }
+    state.random_engine = frames[target].random_engine;
+    state.next_coral_ID = frames[target].next_coral_ID;
+    state.random_mode = frames[target].random_mode;
+    state.random_seed = frames[target].random_seed;
+    state_memory = trajectory::memoryUsed(state);
+    positioned = true;
+    return true;
+}
+
+const Simulation::Snapshot& Timeline::getState() const {
+    return state;
+}
+
+size_t Timeline::index_after(unsigned long tick) const {
+    return std::upper_bound(frames.begin(), frames.end(), tick,
+                            [](unsigned long value, const Frame& frame) {
+                                return value < frame.tick;
+                            }) -
+           frames.begin();
+}
+
+size_t Timeline::working_memory() const {
+    return encoder.getMemoryUsed() + frame.capacity() +
+           trajectory::memoryUsed(resume) + state_memory;
+}
+
+bool Timeline::drop_oldest() {
+    if (frames.empty()) {
+        return false;
+    }
+    auto next_keyframe =
+        std::find_if(frames.begin() + 1, frames.end(),
+                     [](const Frame& frame) { return frame.keyframe; });
+    if (next_keyframe == frames.end()) {
+        return false;
+    }
+    for (auto it = frames.begin(); it != next_keyframe; ++it) {
+        memory_used -= memory_of(*it);
+    }
+    frames.erase(frames.begin(), next_keyframe);
+    return true;
+}
+
+void Timeline::forget_after(unsigned long tick) {
+    size_t after = index_after(tick);
+    for (size_t i = after; i < frames.size(); ++i) {
+        memory_used -= memory_of(frames[i]);
+    }
+    frames.erase(frames.begin() + after, frames.end());
+    if (positioned && state.tick > tick) {
+        positioned = false;  // the frames it was decoded from are gone
+    }
+    frames_since_keyframe = 0;  // the encoder remembers a frame that is gone
+}
+
+size_t Timeline::memory_of(const Frame& frame) {
+    return sizeof(Frame) + frame.data.capacity() + frame.random_engine.capacity();
+}
@@ -0,0 +1,92 @@
+/**
+ * File: Timeline.h
+ * -----------------
+ * Description: Defines the Timeline class, the recent history of the simulation
+ *              shown in the window, so that any recent update can be seen again
+ *              and the simulation started again from it.
+ *
+ *              The updates are kept in memory as the frames of Trajectory.h: a
+ *              binary keyframe every keyframe_interval updates and a delta for
+ *              each update in between. Seeking decodes from the last keyframe
+ *              before the tick, or forward from the state shown when that is
+ *              closer, so it costs at most one keyframe and keyframe_interval
+ *              deltas.
+ *
+ *              The memory used is capped by a budget. It counts the frames and what
+ *              the timeline keeps beside them: the copy of the corals and
+ *              scavengers the encoder compares the next update to, the state last
+ *              decoded and the text of the random engine of each frame. The frames
+ *              form a ring: once over the budget, the oldest keyframe and its
+ *              deltas are dropped, a delta being useless without the keyframe
+ *              before it.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <deque>
+#include <string>
+
+#include "Simulation.h"
+#include "Trajectory.h"
+
+class Timeline {
+public:
+    static constexpr size_t default_budget = size_t(256) << 20;  // bytes
+
+    explicit Timeline(size_t budget_ = default_budget,
+                      unsigned keyframe_interval_ = 100);
+
+    void setBudget(size_t bytes);  // drops the oldest frames that no longer fit
+    size_t getBudget() const;
+    size_t getMemoryUsed() const;  // by the frames and the state kept beside them
+
+    // one frame after each update; a tick already recorded, after a restore to an
+    // earlier one, replaces it and forgets the frames after it
+    void record(const Simulation& simulation);
+    void clear();  // before another file is read
+
+    bool empty() const;
+    unsigned long getFirstTick() const;
+    unsigned long getLastTick() const;
+
+    // state becomes the one recorded at tick, with what Simulation::restore needs
+    // to go on from it; false when tick is no longer or not yet recorded
+    bool seek(unsigned long tick);
+    const Simulation::Snapshot& getState() const;
+
+private:
+    struct Frame {
+        unsigned long tick;
+        bool keyframe;
+        trajectory::Bytes data;
+        // from Simulation::takeResumeState
+        std::string random_engine;
+        int next_coral_ID;
+        Simulation::RandomMode random_mode;
+        unsigned long random_seed;
+    };
+    std::deque<Frame> frames;  // by tick, the first one is always a keyframe
+    size_t budget;
+    size_t memory_used;
+    unsigned keyframe_interval;
+    unsigned frames_since_keyframe;
+    trajectory::Encoder encoder;
+    trajectory::Bytes frame;
+    Simulation::Snapshot resume;  // only its resume state is used
+    Simulation::Snapshot state;
+    size_t state_memory;  // trajectory::memoryUsed(state), as of the last seek
+    bool positioned;  // state is the one of frames at state.tick
+
+    size_t index_after(unsigned long tick) const;  // first frame later than tick
+    size_t working_memory() const;  // what is kept beside the frames
+    bool drop_oldest();  // the first keyframe and its deltas, false if the last
+    void forget_after(unsigned long tick);
+    static size_t memory_of(const Frame& frame);
+};
+
+#endif  // TIMELINE_H
@@ -0,0 +1,149 @@
+/**
+ * File: Trace.cpp
+ * ----------------
+ * Description: Implements the tracer declared in Trace.h: one single producer,
+ *              single consumer ring buffer per thread and the Chrome trace-event
+ *              JSON writer.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "Trace.h"
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace trace {
+std::atomic<bool> active(false);
+}
+
+namespace {
+constexpr size_t buffer_capacity(1 << 16);  // events per thread, power of two
+
+struct Event {
+    const char* name;
+    unsigned long long time_ns;  // since the start of the program
+    char phase;                  // 'B' or 'E' as in the trace-event format
+};
+
+struct ThreadBuffer {
+    explicit ThreadBuffer(unsigned tid_)
+        : tid(tid_), events(new Event[buffer_capacity]) {}
+
+    unsigned tid;
+    std::unique_ptr<Event[]> events;
+    std::atomic<size_t> head{0};  // next event to read, written by flush only
+    std::atomic<size_t> tail{0};  // next slot to write, written by the owner only
+    std::atomic<unsigned long long> dropped{0};
+    size_t open_scopes{0};  // begins without their end yet, owner only
+};
+
+const auto epoch = std::chrono::steady_clock::now();
+
+// buffers are never freed so the events of a finished thread can still be flushed
+std::mutex buffers_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+thread_local ThreadBuffer* local_buffer(nullptr);
+
+ThreadBuffer& own_buffer() {
+    if (!local_buffer) {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>(buffers.size()));
+        local_buffer = buffers.back().get();
+    }
+    return *local_buffer;
+}
+
+// the caller made sure the slot at tail is free
+void record(ThreadBuffer& buffer, size_t tail, const char* name, char phase) {
+    auto elapsed = std::chrono::steady_clock::now() - epoch;
+    buffer.events[tail & (buffer_capacity - 1)] = {
+        name,
+        static_cast<unsigned long long>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+        phase};
+    buffer.tail.store(tail + 1, std::memory_order_release);
+}
+
+// the caller holds buffers_mutex
+unsigned long long total_dropped() {
+    unsigned long long total(0);
+    for (const auto& buffer : buffers) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+}  // namespace
+
+void trace::set_enabled(bool enabled) {
+    active.store(enabled, std::memory_order_relaxed);
+}
+
+bool trace::is_enabled() {
+    return active.load(std::memory_order_relaxed);
+}
+
+bool trace::begin(const char* name) {
+    ThreadBuffer& buffer = own_buffer();
+    size_t tail = buffer.tail.load(std::memory_order_relaxed);
+    size_t used = tail - buffer.head.load(std::memory_order_acquire);
+    // this begin, its end and the ends of the scopes open around it
+    if (used + buffer.open_scopes + 2 > buffer_capacity) {
+        buffer.dropped.fetch_add(2, std::memory_order_relaxed);
+        return false;
+    }
+    record(buffer, tail, name, 'B');
+    ++buffer.open_scopes;
+    return true;
+}
+
+void trace::end(const char* name) {
+    ThreadBuffer& buffer = own_buffer();
+    --buffer.open_scopes;  // its slot was kept by begin
+    record(buffer, buffer.tail.load(std::memory_order_relaxed), name, 'E');
+}
+
+bool trace::flush(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(buffers_mutex);  // one flush at a time
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buffer : buffers) {
+        size_t head = buffer->head.load(std::memory_order_relaxed);
+        size_t tail = buffer->tail.load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            const Event& event = buffer->events[head & (buffer_capacity - 1)];
+            out << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name
+                << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << event.time_ns / 1000
+                << '.' << event.time_ns / 100 % 10 << event.time_ns / 10 % 10
+                << event.time_ns % 10 << ",\"pid\":1,\"tid\":" << buffer->tid << '}';
+            first = false;
+        }
+        buffer->head.store(tail, std::memory_order_release);
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":"
+        << total_dropped() << "}}\n";
+    return bool(out);
+}
+
+void trace::discard() {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for (const auto& buffer : buffers) {
+        buffer->head.store(buffer->tail.load(std::memory_order_acquire),
+                           std::memory_order_release);
+    }
+}
+
+unsigned long long trace::dropped_events() {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    return total_dropped();
+}
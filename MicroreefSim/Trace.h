@@ -0,0 +1,68 @@
+/**
+ * File: Trace.h
+ * --------------
+ * Description: Optional tracer of the simulation. While it is on, every TRACE_SCOPE
+ *              records a begin and an end event in a ring buffer owned by the
+ *              calling thread, without any lock: the thread is the only writer
+ *              of its buffer and flush() the only reader. flush() drains all the
+ *              buffers into a Chrome trace-event JSON file that can be opened in
+ *              chrome://tracing or Perfetto.
+ *
+ *              When the tracer is off a TRACE_SCOPE only reads one atomic flag.
+ *              When a buffer is full, whole scopes are dropped and counted: a
+ *              begin is only recorded if there is room left for its end and for
+ *              the ends of the scopes still open, so the file stays balanced.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <string>
+
+namespace trace {
+extern std::atomic<bool> active;
+
+void set_enabled(bool enabled);
+bool is_enabled();
+
+// name must be a string literal (only the pointer is stored); false when the
+// buffer is full and the scope is dropped, its end must then not be recorded
+bool begin(const char* name);
+void end(const char* name);  // only after a begin that returned true
+
+// writes the events recorded since the last flush to filename, returns false if
+// the file could not be written
+bool flush(const std::string& filename);
+// forgets the events recorded since the last flush
+void discard();
+unsigned long long dropped_events();
+
+class Scope {
+public:
+    explicit Scope(const char* name_)
+        : name(active.load(std::memory_order_relaxed) ? name_ : nullptr) {
+        if (name && !begin(name)) {
+            name = nullptr;
+        }
+    }
+    ~Scope() {
+        if (name) {
+            end(name);
+        }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name;  // nullptr when the tracer was off or the begin dropped
+};
+}  // namespace trace
+
+#define TRACE_SCOPE(name) trace::Scope trace_scope(name)
+
+#endif  // TRACE_H
@@ -0,0 +1,775 @@
+/**
+ * File: Trajectory.cpp
+ * ---------------------
+ * Description: Implements the encoder, the recorder and the player of
+ *              Trajectory.h.
+ *
+ *              Frame layout: the tick, then for the algae, the corals and the
+ *              scavengers in turn
+ *              - a keyframe: the number of entities and their records;
+ *              - a delta: the positions removed from the old vector, the entities
+ *                changed (position in the new vector and what changed) and the
+ *                records of the entities born.
+ *              Positions are written as the difference with the previous one, all
+ *              counts and integers as varints.
+ *
+ *              File layout: a magic string, then per frame its type (K or D), its
+ *              size and its bytes.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#include "Trajectory.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Trace.h"
+
+using trajectory::Bytes;
+
+namespace {
+constexpr char magic[] = "MRTRAJ1\n";
+constexpr size_t magic_size(sizeof(magic) - 1);
+constexpr char keyframe_type('K');
+constexpr char delta_type('D');
+
+// how an entity kept from the frame before is written
+enum Change : unsigned char {
+    FULL,                // the whole record
+    CORAL_TAIL,          // status, counts and the segments from the first changed
+    SCAVENGER_POSITION,  // only the position
+};
+
+//-------------------writing-------------------
+void put_byte(Bytes& out, unsigned char value) {
+    out.push_back(static_cast<char>(value));
+}
+
+void put_varint(Bytes& out, unsigned long long value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void put_signed(Bytes& out, long long value) {  // zigzag, small magnitudes are short
+    put_varint(out, (static_cast<unsigned long long>(value) << 1) ^
+                        static_cast<unsigned long long>(value >> 63));
+}
+
+void put_double(Bytes& out, double value) {
+    char raw[sizeof(double)];
+    std::memcpy(raw, &value, sizeof(double));
+    out.append(raw, sizeof(double));
+}
+
+void put_position(Bytes& out, const S2d& position) {
+    put_double(out, position.x);
+    put_double(out, position.y);
+}
+
+void put_segment(Bytes& out, const Segment& segment) {
+    put_position(out, segment.getBase());
+    put_double(out, segment.getAngle());
+    put_double(out, segment.getLength());
+}
+
+void put_record(Bytes& out, const Algae& algae) {
+    put_position(out, algae.getPosition());
+    put_signed(out, algae.getBirthTick());
+}
+
+void put_record(Bytes& out, const Coral& coral) {
+    put_position(out, coral.getPosition());
+    put_signed(out, coral.getBirthTick());
+    put_signed(out, coral.getID());
+    put_byte(out, coral.getStatut());
+    put_byte(out, coral.getDirectionRotation());
+    put_byte(out, coral.getStatutDev());
+    put_varint(out, coral.getNbSeg());
+    put_varint(out, coral.getSegments().size());
+    for (const auto& segment : coral.getSegments()) {
+        put_segment(out, segment);
+    }
+}
+
+void put_record(Bytes& out, const Scavenger& scavenger) {
+    put_position(out, scavenger.getPosition());
+    put_double(out, scavenger.getRadius());
+    put_signed(out, scavenger.getBirthTick());
+    put_byte(out, scavenger.getStatus());
+    put_signed(out, scavenger.getTargetCoralId());
+}
+
+// exact comparisons: S2d::operator== tolerates epsil_zero, a replay must not
+bool same(const S2d& a, const S2d& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+bool same(const Segment& a, const Segment& b) {
+    return same(a.getBase(), b.getBase()) && a.getAngle() == b.getAngle() &&
+           a.getLength() == b.getLength();
+}
+
+bool same(const Algae& a, const Algae& b) {
+    return same(a.getPosition(), b.getPosition()) &&
+           a.getBirthTick() == b.getBirthTick();
+}
+
+bool same(const Coral& a, const Coral& b) {
+    const SegmentVector& segments = a.getSegments();
+    const SegmentVector& other_segments = b.getSegments();
+    return same(a.getPosition(), b.getPosition()) &&
+           a.getBirthTick() == b.getBirthTick() && a.getID() == b.getID() &&
+           a.getStatut() == b.getStatut() &&
+           a.getDirectionRotation() == b.getDirectionRotation() &&
+           a.getStatutDev() == b.getStatutDev() && a.getNbSeg() == b.getNbSeg() &&
+           std::equal(segments.begin(), segments.end(), other_segments.begin(),
+                      other_segments.end(),
+                      [](const Segment& s, const Segment& t) { return same(s, t); });
+}
+
+bool same(const Scavenger& a, const Scavenger& b) {
+    return same(a.getPosition(), b.getPosition()) && a.getRadius() == b.getRadius() &&
+           a.getBirthTick() == b.getBirthTick() && a.getStatus() == b.getStatus() &&
+           a.getTargetCoralId() == b.getTargetCoralId();
+}
+
+void put_change(Bytes& out, const Algae&, const Algae& now) {
+    put_byte(out, FULL);
+    put_record(out, now);
+}
+
+void put_change(Bytes& out, const Coral& before, const Coral& now) {
+    // setNbSeg refuses 0, such a coral is written whole
+    if (!same(before.getPosition(), now.getPosition()) ||
+        before.getBirthTick() != now.getBirthTick() || before.getID() != now.getID() ||
+        now.getNbSeg() == 0) {
+        put_byte(out, FULL);
+        put_record(out, now);
+        return;
+    }
+    const SegmentVector& old_segments = before.getSegments();
+    const SegmentVector& segments = now.getSegments();
+    size_t common = std::min(old_segments.size(), segments.size());
+    size_t first_changed =
+        std::mismatch(segments.begin(), segments.begin() + common, old_segments.begin(),
+                      [](const Segment& s, const Segment& t) { return same(s, t); })
+            .first -
+        segments.begin();
+    put_byte(out, CORAL_TAIL);
+    put_byte(out, now.getStatut());
+    put_byte(out, now.getDirectionRotation());
+    put_byte(out, now.getStatutDev());
+    put_varint(out, now.getNbSeg());
+    put_varint(out, segments.size());
+    put_varint(out, first_changed);
+    for (size_t i = first_changed; i < segments.size(); ++i) {
+        put_segment(out, segments[i]);
+    }
+}
+
+void put_change(Bytes& out, const Scavenger& before, const Scavenger& now) {
+    if (before.getRadius() == now.getRadius() &&
+        before.getBirthTick() == now.getBirthTick() &&
+        before.getStatus() == now.getStatus() &&
+        before.getTargetCoralId() == now.getTargetCoralId()) {
+        put_byte(out, SCAVENGER_POSITION);
+        put_position(out, now.getPosition());
+        return;
+    }
+    put_byte(out, FULL);
+    put_record(out, now);
+}
+
+void handles_of(size_t count, Handle (Simulation::*handle_at)(size_t) const,
+                const Simulation& simulation, std::vector<Handle>& handles) {
+    handles.clear();
+    handles.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        handles.push_back((simulation.*handle_at)(i));
+    }
+}
+
+//-------------------memory-------------------
+template <class T, class Allocator>
+size_t memory_of(const std::vector<T, Allocator>& values) {
+    return values.capacity() * sizeof(T);
+}
+
+size_t memory_of(const std::vector<Coral>& corals) {
+    size_t bytes = memory_of<Coral>(corals);
+    for (const auto& coral : corals) {
+        bytes += memory_of(coral.getSegments());
+    }
+    return bytes;
+}
+
+// what an entity allocates beyond its own size
+size_t heap_of(const Algae&) {
+    return 0;
+}
+
+size_t heap_of(const Coral& coral) {
+    return memory_of(coral.getSegments());
+}
+
+size_t heap_of(const Scavenger&) {
+    return 0;
+}
+
+// the part of a delta for one kind of entity: the entities of before missing from
+// now, as positions in before, then the ones that changed and the new ones; now
+// keeps the others in the same order and adds the new ones at its end. Without
+// states, the entities kept never change (algae). With them, states becomes the
+// entities of now, only those changed or new being copied, and heap follows what
+// they allocate (heap_of)
+template <class Entity>
+void put_delta(Bytes& out, const std::vector<Handle>& old_handles,
+               const std::vector<Handle>& handles, std::vector<Entity>* states,
+               size_t& heap, const std::vector<Entity>& entities, Bytes& scratch) {
+    size_t kept(0);
+    size_t removed(0);
+    scratch.clear();
+    size_t previous(0);
+    for (size_t i = 0; i < old_handles.size(); ++i) {
+        if (kept < handles.size() && old_handles[i] == handles[kept]) {
+            ++kept;
+        } else {
+            put_varint(scratch, i - previous);
+            previous = i;
+            ++removed;
+        }
+    }
+    put_varint(out, removed);
+    out += scratch;
+
+    scratch.clear();
+    size_t changed(0);
+    previous = 0;
+    if (states) {
+        // compacts states in the same pass, j never passes i
+        for (size_t i = 0, j = 0; j < kept; ++i) {
+            if (old_handles[i] != handles[j]) {
+                continue;  // removed
+            }
+            Entity& state = (*states)[j];
+            if (!same((*states)[i], entities[j])) {
+                put_varint(scratch, j - previous);
+                previous = j;
+                put_change(scratch, (*states)[i], entities[j]);
+                heap -= heap_of(state);
+                state = entities[j];
+                heap += heap_of(state);
+                ++changed;
+            } else if (i != j) {
+                heap -= heap_of(state) + heap_of((*states)[i]);
+                state = std::move((*states)[i]);
+                heap += heap_of(state) + heap_of((*states)[i]);
+            }
+            ++j;
+        }
+        for (size_t i = kept; i < states->size(); ++i) {
+            heap -= heap_of((*states)[i]);
+        }
+        states->erase(states->begin() + kept, states->end());
+        states->insert(states->end(), entities.begin() + kept, entities.end());
+        for (size_t i = kept; i < states->size(); ++i) {
+            heap += heap_of((*states)[i]);
+        }
+    }
+    put_varint(out, changed);
+    out += scratch;
+
+    put_varint(out, entities.size() - kept);
+    for (size_t j = kept; j < entities.size(); ++j) {
+        put_record(out, entities[j]);
+    }
+}
+
+//-------------------reading-------------------
+class Reader {
+public:
+    Reader(const char* data, size_t size) : next(data), end(data + size), valid(true) {}
+
+    unsigned char byte() {
+        if (next == end) {
+            valid = false;
+            return 0;
+        }
+        return static_cast<unsigned char>(*next++);
+    }
+    unsigned long long varint() {
+        unsigned long long value(0);
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            unsigned char part = byte();
+            value |= static_cast<unsigned long long>(part & 0x7f) << shift;
+            if (!(part & 0x80)) {
+                return value;
+            }
+        }
+        valid = false;
+        return 0;
+    }
+    long long signed_varint() {
+        unsigned long long value = varint();
+        return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+    }
+    double real() {
+        double value(0);
+        if (end - next < static_cast<std::ptrdiff_t>(sizeof(double))) {
+            valid = false;
+            return value;
+        }
+        std::memcpy(&value, next, sizeof(double));
+        next += sizeof(double);
+        return value;
+    }
+    S2d position() {
+        double x = real();
+        return S2d{x, real()};
+    }
+    Segment segment() {
+        S2d base = position();
+        double angle = real();
+        return Segment(base, angle, real());
+    }
+    // count records of at least one byte can still be there, guards the reserves
+    bool fits(unsigned long long count) const {
+        return valid && count <= static_cast<unsigned long long>(end - next);
+    }
+    bool ok() const {
+        return valid;
+    }
+
+private:
+    const char* next;
+    const char* end;
+    bool valid;
+};
+
+void get_record(Reader& in, Algae& algae) {
+    S2d position = in.position();
+    algae = Algae(position, 0);
+    algae.setBirthTick(in.signed_varint());
+}
+
+void get_record(Reader& in, Coral& coral) {
+    S2d position = in.position();
+    long long birth = in.signed_varint();
+    int ID = static_cast<int>(in.signed_varint());
+    Statut_cor statut = static_cast<Statut_cor>(in.byte());
+    Dir_rot_cor direction = static_cast<Dir_rot_cor>(in.byte());
+    Statut_dev statut_dev = static_cast<Statut_dev>(in.byte());
+    unsigned int nbseg = static_cast<unsigned int>(in.varint());
+    unsigned long long count = in.varint();
+    SegmentVector segments;
+    if (in.fits(count)) {
+        segments.reserve(count);
+        for (unsigned long long i = 0; i < count && in.ok(); ++i) {
+            segments.push_back(in.segment());
+        }
+    }
+    coral = Coral(position, 0, ID, statut, direction, statut_dev, nbseg, 0, 0);
+    coral.setSegments(segments);
+    coral.setBirthTick(birth);
+}
+
+void get_record(Reader& in, Scavenger& scavenger) {
+    S2d position = in.position();
+    double radius = in.real();
+    long long birth = in.signed_varint();
+    Statut_sca status = static_cast<Statut_sca>(in.byte());
+    int target = static_cast<int>(in.signed_varint());
+    scavenger = Scavenger(position, 0, radius, status, target);
+    scavenger.setBirthTick(birth);
+}
+
+bool get_change(Reader& in, Algae& algae) {
+    if (in.byte() != FULL) {
+        return false;
+    }
+    get_record(in, algae);
+    return in.ok();
+}
+
+bool get_change(Reader& in, Coral& coral) {
+    unsigned char change = in.byte();
+    if (change == FULL) {
+        get_record(in, coral);
+        return in.ok();
+    }
+    if (change != CORAL_TAIL) {
+        return false;
+    }
+    coral.setStatut(static_cast<Statut_cor>(in.byte()));
+    coral.setDirectionRotation(static_cast<Dir_rot_cor>(in.byte()));
+    coral.setStatutDev(static_cast<Statut_dev>(in.byte()));
+    coral.setNbSeg(static_cast<unsigned int>(in.varint()));
+    unsigned long long count = in.varint();
+    unsigned long long first_changed = in.varint();
+    const SegmentVector& old_segments = coral.getSegments();
+    if (!in.fits(count) || first_changed > count ||
+        first_changed > old_segments.size()) {
+        return false;
+    }
+    SegmentVector segments(old_segments.begin(), old_segments.begin() + first_changed);
+    segments.reserve(count);
+    for (unsigned long long i = first_changed; i < count; ++i) {
+        segments.push_back(in.segment());
+    }
+    coral.setSegments(segments);
+    return in.ok();
+}
+
+bool get_change(Reader& in, Scavenger& scavenger) {
+    unsigned char change = in.byte();
+    if (change == SCAVENGER_POSITION) {
+        scavenger.setPosition(in.position());
+        return in.ok();
+    }
+    if (change != FULL) {
+        return false;
+    }
+    get_record(in, scavenger);
+    return in.ok();
+}
+
+// appends count records read from in
+template <class Entity>
+bool get_records(Reader& in, unsigned long long count, std::vector<Entity>& entities) {
+    if (!in.fits(count)) {
+        return false;
+    }
+    entities.reserve(entities.size() + count);
+    for (unsigned long long i = 0; i < count && in.ok(); ++i) {
+        get_record(in, entities.emplace_back(S2d{0, 0}, 0));
+    }
+    return in.ok();
+}
+
+template <>
+bool get_records(Reader& in, unsigned long long count, std::vector<Coral>& corals) {
+    if (!in.fits(count)) {
+        return false;
+    }
+    corals.reserve(corals.size() + count);
+    for (unsigned long long i = 0; i < count && in.ok(); ++i) {
+        get_record(in, corals.emplace_back(S2d{0, 0}, 0, 0, ALIVE, TRIGO, EXTEND, 1,
+                                           0, 0));
+    }
+    return in.ok();
+}
+
+// the inverse of put_delta
+template <class Entity>
+bool get_delta(Reader& in, std::vector<Entity>& entities) {
+    unsigned long long removed = in.varint();
+    if (!in.ok() || removed > entities.size()) {
+        return false;
+    }
+    // compacts in one pass while the positions are read, as erase_entities_if
+    unsigned long long read(0);
+    size_t next_removed = removed > 0 ? in.varint() : entities.size();
+    size_t kept(0);
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (read < removed && i == next_removed) {
+            if (++read < removed) {
+                next_removed += in.varint();
+            }
+            continue;
+        }
+        if (kept != i) {
+            entities[kept] = std::move(entities[i]);
+        }
+        ++kept;
+    }
+    if (read != removed || !in.ok()) {
+        return false;
+    }
+    entities.erase(entities.begin() + kept, entities.end());
+
+    unsigned long long changed = in.varint();
+    size_t position(0);
+    for (unsigned long long i = 0; i < changed && in.ok(); ++i) {
+        position += in.varint();
+        if (position >= entities.size() || !get_change(in, entities[position])) {
+            return false;
+        }
+    }
+    return in.ok() && get_records(in, in.varint(), entities);
+}
+}  // namespace
+
+//-------------------Encoder-------------------
+void trajectory::Encoder::keyframe(const Simulation& simulation, Bytes& frame) {
+    frame.clear();
+    put_varint(frame, simulation.getTick());
+    put_varint(frame, simulation.get_algae_in_simulation().size());
+    for (const auto& algae : simulation.get_algae_in_simulation()) {
+        put_record(frame, algae);
+    }
+    put_varint(frame, simulation.get_coral_in_simulation().size());
+    for (const auto& coral : simulation.get_coral_in_simulation()) {
+        put_record(frame, coral);
+    }
+    put_varint(frame, simulation.get_scavenger_in_simulation().size());
+    for (const auto& scavenger : simulation.get_scavenger_in_simulation()) {
+        put_record(frame, scavenger);
+    }
+    remember(simulation);
+}
+
+void trajectory::Encoder::delta(const Simulation& simulation, Bytes& frame) {
+    TRACE_SCOPE("trajectory delta");
+    frame.clear();
+    put_varint(frame, simulation.getTick());
+    Bytes scratch;
+    std::vector<Handle> handles;
+    handles_of(simulation.getAlgaeCount(), &Simulation::getAlgaeHandle, simulation,
+               handles);
+    size_t algae_heap(0);  // an algae allocates nothing
+    put_delta<Algae>(frame, algae_handles, handles, nullptr, algae_heap,
+                     simulation.get_algae_in_simulation(), scratch);
+    algae_handles.swap(handles);
+
+    handles_of(simulation.getCoralCount(), &Simulation::getCoralHandle, simulation,
+               handles);
+    put_delta(frame, coral_handles, handles, &corals, segment_memory,
+              simulation.get_coral_in_simulation(), scratch);
+    coral_handles.swap(handles);
+
+    handles_of(simulation.getScavengerCount(), &Simulation::getScavengerHandle,
+               simulation, handles);
+    size_t scavenger_heap(0);  // nor does a scavenger
+    put_delta(frame, scavenger_handles, handles, &scavengers, scavenger_heap,
+              simulation.get_scavenger_in_simulation(), scratch);
+    scavenger_handles.swap(handles);
+}
+
+size_t trajectory::Encoder::getMemoryUsed() const {
+    return memory_of(algae_handles) + memory_of(coral_handles) +
+           memory_of(scavenger_handles) + memory_of<Coral>(corals) + segment_memory +
+           memory_of(scavengers);
+}
+
+void trajectory::Encoder::remember(const Simulation& simulation) {
+    handles_of(simulation.getAlgaeCount(), &Simulation::getAlgaeHandle, simulation,
+               algae_handles);
+    handles_of(simulation.getCoralCount(), &Simulation::getCoralHandle, simulation,
+               coral_handles);
+    handles_of(simulation.getScavengerCount(), &Simulation::getScavengerHandle,
+               simulation, scavenger_handles);
+    corals = simulation.get_coral_in_simulation();
+    scavengers = simulation.get_scavenger_in_simulation();
+    segment_memory = memory_of(corals) - memory_of<Coral>(corals);
+}
+
+size_t trajectory::memoryUsed(const Simulation::Snapshot& state) {
+    return memory_of(state.algae) + memory_of(state.corals) +
+           memory_of(state.scavengers) + state.random_engine.capacity();
+}
+
+bool trajectory::applyKeyframe(const char* data, size_t size,
+                               Simulation::Snapshot& state) {
+    Reader in(data, size);
+    state.tick = in.varint();
+    state.algae.clear();
+    state.corals.clear();
+    state.scavengers.clear();
+    return get_records(in, in.varint(), state.algae) &&
+           get_records(in, in.varint(), state.corals) &&
+           get_records(in, in.varint(), state.scavengers);
+}
+
+bool trajectory::applyDelta(const char* data, size_t size,
+                             Simulation::Snapshot& state) {
+    Reader in(data, size);
+    state.tick = in.varint();
+    return get_delta(in, state.algae) && get_delta(in, state.corals) &&
+           get_delta(in, state.scavengers);
+}
+
+unsigned long trajectory::frameTick(const char* data, size_t size) {
+    Reader in(data, size);
+    return in.varint();
+}
+
+//-------------------TrajectoryRecorder-------------------
+TrajectoryRecorder::TrajectoryRecorder(unsigned keyframe_interval_)
+    : keyframe_interval(std::max(keyframe_interval_, 1u)),
+      frames_written(0),
+      frames_since_keyframe(0),
+      bytes_written(0) {}
+
+TrajectoryRecorder::~TrajectoryRecorder() {
+    close();
+}
+
+bool TrajectoryRecorder::open(const std::string& filename) {
+    close();
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file.write(magic, magic_size);
+    bytes_written = magic_size;
+    frames_written = 0;
+    frames_since_keyframe = 0;
+    return true;
+}
+
+void TrajectoryRecorder::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+bool TrajectoryRecorder::isOpen() const {
+    return file.is_open();
+}
+
+void TrajectoryRecorder::record(const Simulation& simulation) {
+    if (!file.is_open()) {
+        return;
+    }
+    TRACE_SCOPE("TrajectoryRecorder::record");
+    bool keyframe = frames_since_keyframe == 0;
+    if (keyframe) {
+        encoder.keyframe(simulation, frame);
+    } else {
+        encoder.delta(simulation, frame);
+    }
+    Bytes header(1, keyframe ? keyframe_type : delta_type);
+    put_varint(header, frame.size());
+    file.write(header.data(), header.size());
+    file.write(frame.data(), frame.size());
+    bytes_written += header.size() + frame.size();
+    ++frames_written;
+    frames_since_keyframe = (frames_since_keyframe + 1) % keyframe_interval;
+}
+
+void TrajectoryRecorder::restart() {
+    frames_since_keyframe = 0;
+}
+
+unsigned long long TrajectoryRecorder::getBytesWritten() const {
+    return bytes_written;
+}
+
+unsigned long TrajectoryRecorder::getFramesWritten() const {
+    return frames_written;
+}
+
+//-------------------TrajectoryPlayer-------------------
+TrajectoryPlayer::TrajectoryPlayer()
+    : state{{}, {}, {}, 0, {}, 0, Simulation::ENGINE, 1}, current(0) {}
+
+bool TrajectoryPlayer::open(const std::string& filename) {
+    frames.clear();
+    current = 0;
+    file.close();
+    file.open(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    std::streamoff file_size = file.tellg();
+    file.seekg(0);
+    char header[magic_size];
+    if (!file.read(header, magic_size) || std::memcmp(header, magic, magic_size)) {
+        file.close();
+        return false;
+    }
+    // a frame cut short, by a run that stopped while writing it, ends the index
+    char frame_header[11];
+    while (true) {
+        std::streamoff start = file.tellg();
+        size_t read = std::min<std::streamoff>(sizeof(frame_header), file_size - start);
+        if (read < 2 || !file.read(frame_header, read)) {
+            break;
+        }
+        Reader in(frame_header + 1, read - 1);
+        unsigned long long size = in.varint();
+        size_t varint_size(1);  // one to ten bytes, in.ok() checked it ended
+        while (varint_size < read - 1 &&
+               static_cast<unsigned char>(frame_header[varint_size]) & 0x80) {
+            ++varint_size;
+        }
+        std::streamoff data = start + 1 + varint_size;
+        char type = frame_header[0];
+        if (!in.ok() || (type != keyframe_type && type != delta_type) ||
+            data + static_cast<std::streamoff>(size) > file_size) {
+            break;
+        }
+        char tick_bytes[10];
+        size_t tick_size = std::min<unsigned long long>(sizeof(tick_bytes), size);
+        file.seekg(data);
+        file.read(tick_bytes, tick_size);
+        frames.push_back({trajectory::frameTick(tick_bytes, tick_size), data,
+                          static_cast<size_t>(size), type == keyframe_type});
+        file.seekg(data + static_cast<std::streamoff>(size));
+    }
+    file.clear();
+    current = frames.size();
+    return !frames.empty() && frames.front().keyframe;
+}
+
+size_t TrajectoryPlayer::getFrameCount() const {
+    return frames.size();
+}
+
+unsigned long TrajectoryPlayer::getFirstTick() const {
+    return frames.empty() ? 0 : frames.front().tick;
+}
+
+unsigned long TrajectoryPlayer::getLastTick() const {
+    return frames.empty() ? 0 : frames.back().tick;
+}
+
+bool TrajectoryPlayer::seek(unsigned long tick) {
+    auto after = std::upper_bound(
+        frames.begin(), frames.end(), tick,
+        [](unsigned long value, const Entry& entry) { return value < entry.tick; });
+    if (after == frames.begin()) {
+        return false;
+    }
+    size_t target = after - frames.begin() - 1;
+    size_t keyframe = target;
+    while (!frames[keyframe].keyframe) {
+        --keyframe;  // the first frame is a keyframe, open checked it
+    }
+    size_t from = keyframe;
+    if (current < frames.size() && current >= keyframe && current <= target) {
+        from = current + 1;  // going forward without passing a keyframe
+    }
+    for (size_t i = from; i <= target; ++i) {
+        if (!apply(i)) {
+            current = frames.size();
+            return false;
+        }
+    }
+    current = target;
+    return true;
+}
+
+const Simulation::Snapshot& TrajectoryPlayer::getState() const {
+    return state;
+}
+
+bool TrajectoryPlayer::apply(size_t index) {
+    const Entry& entry = frames[index];
+    buffer.resize(entry.size);
+    file.seekg(entry.offset);
+    if (!file.read(buffer.data(), entry.size)) {
+        file.clear();
+        return false;
+    }
+    if (entry.keyframe) {
+        return trajectory::applyKeyframe(buffer.data(), buffer.size(), state);
+    }
+    return trajectory::applyDelta(buffer.data(), buffer.size(), state);
+}
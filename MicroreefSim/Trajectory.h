@@ -0,0 +1,128 @@
+/**
+ * File: Trajectory.h
+ * -------------------
+ * Description: Records the whole history of a run and plays it back, far more
+ *              compactly than one saveSimulation per update.
+ *
+ *              A frame is either a keyframe, the full state in binary, or a delta
+ *              from the frame before: the entities removed, the ones that changed
+ *              and the ones born. The entities are matched from one frame to the
+ *              next by their handles (Handle.h). The vectors keep their order and
+ *              only grow at the end, so one merge pass finds the removed entities.
+ *              An update only moves scavengers and rotates, extends or adds the last
+ *              segments of corals. A changed coral is written from its first
+ *              changed segment and a scavenger that only moved as a position, so a
+ *              delta is a few bytes per active entity.
+ *
+ *              TrajectoryRecorder writes the frames to a file, with a keyframe every
+ *              keyframe_interval frames. TrajectoryPlayer indexes them when the file
+ *              is opened and seeks to a tick from the last keyframe before it.
+ *              Numbers are written in the byte order of the machine.
+ *
+ * Authors: Bahey Shalash
+ * Version: 1.0
+ * Date: 18/10/2026
+ */
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Simulation.h"
+
+namespace trajectory {
+using Bytes = std::string;  // one encoded frame
+
+// encodes the frames of one simulation; a delta is relative to the frame encoded
+// just before, so the first frame, and the first after the simulation was
+// replaced or read again, must be a keyframe
+class Encoder {
+public:
+    void keyframe(const Simulation& simulation, Bytes& frame);
+    void delta(const Simulation& simulation, Bytes& frame);
+    size_t getMemoryUsed() const;  // by the state it remembers, in bytes
+
+private:
+    // at the last frame encoded: the handles of the entities and the state of
+    // those that can change (an algae never does)
+    std::vector<Handle> algae_handles;
+    std::vector<Handle> coral_handles;
+    std::vector<Handle> scavenger_handles;
+    std::vector<Coral> corals;
+    std::vector<Scavenger> scavengers;
+    size_t segment_memory = 0;  // allocated by the segments of corals
+
+    void remember(const Simulation& simulation);
+};
+
+// applies a frame to state, deltas in the order they were encoded; false if the
+// frame is truncated or not of this kind, state is then unusable
+bool applyKeyframe(const char* data, size_t size, Simulation::Snapshot& state);
+bool applyDelta(const char* data, size_t size, Simulation::Snapshot& state);
+unsigned long frameTick(const char* data, size_t size);  // the tick it encodes
+// the bytes allocated by the entities and the strings of state
+size_t memoryUsed(const Simulation::Snapshot& state);
+}  // namespace trajectory
+
+class TrajectoryRecorder {
+public:
+    explicit TrajectoryRecorder(unsigned keyframe_interval_ = 100);
+    ~TrajectoryRecorder();
+
+    bool open(const std::string& filename);  // false if it cannot be written
+    void close();
+    bool isOpen() const;
+
+    // one frame of the current state, usually after each updateEntities
+    void record(const Simulation& simulation);
+    void restart();  // the next frame is a keyframe, e.g. after another file is read
+
+    unsigned long long getBytesWritten() const;
+    unsigned long getFramesWritten() const;
+
+private:
+    unsigned keyframe_interval;
+    std::ofstream file;
+    trajectory::Encoder encoder;
+    trajectory::Bytes frame;
+    unsigned long frames_written;
+    unsigned long frames_since_keyframe;
+    unsigned long long bytes_written;
+};
+
+class TrajectoryPlayer {
+public:
+    TrajectoryPlayer();
+
+    // reads the index of the frames, false if the file is not a trajectory
+    bool open(const std::string& filename);
+    size_t getFrameCount() const;
+    unsigned long getFirstTick() const;
+    unsigned long getLastTick() const;
+
+    // state becomes the one recorded at tick, or at the last tick recorded before;
+    // from the current state when no keyframe is closer. False before the first
+    // frame or if the file is damaged
+    bool seek(unsigned long tick);
+    const Simulation::Snapshot& getState() const;
+
+private:
+    struct Entry {
+        unsigned long tick;
+        std::streamoff offset;  // of the frame data
+        size_t size;
+        bool keyframe;
+    };
+    std::ifstream file;
+    std::vector<Entry> frames;
+    Simulation::Snapshot state;
+    size_t current;  // index of the frame state is at, frames.size() when none
+    trajectory::Bytes buffer;
+
+    bool apply(size_t index);  // reads and applies frames[index] to state
+};
+
+#endif  // TRAJECTORY_H
@@ -24,6 +24,7 @@
  *      - textile.tct: The file containing initial settings for the simulation. This
  * file should be in the current directory or specified with a relative or absolute
  * path.
+ *      ./projet --<mode> ...: runs one of the modes of Headless.h without window
  *
  * Authors: Bahey Shalash
  * Version: 1.0
@@ -33,9 +34,15 @@
 #include <gtkmm/application.h>
 #include <gtkmm/window.h>
 
+#include "Headless.h"
 #include "SimulationWindow.h"
 
 int main(int argc, char** argv) {
+    int status = 0;
+    if (headless::run(argc, argv, status)) {
+        return status;  // benchmark or batch mode, no window
+    }
+
     Simulation simulation;
     // Vérifier si un argument de ligne de commande est fourni sinon open a empty
     // window
@@ -52,7 +59,9 @@ int main(int argc, char** argv) {
 
     // Poursuivre avec la simulation en utilisant le nom de fichier fourni
 
-    simulation.start(filename);
+    if (!simulation.start(filename)) {
+        return EXIT_FAILURE;  // cannot open the file
+    }
     // simulation.methode_test_demander_par_le_professeur_au_rendu_2("test_prof.txt");
     auto app = Gtk::Application::create();
 
@@ -17,25 +17,11 @@
 
 #include <algorithm>
 
+#include "Stats.h"
+
 Segment::Segment(const S2d& base_, double angle_, double length_)
     : base(base_), angle(angle_), length(length_) {}
 
-Segment::Segment(const Segment& other) {
-    base = other.base;
-    angle = other.angle;
-    length = other.length;
-}
-Segment::~Segment() {}
-
-Segment& Segment::operator=(const Segment& other) {
-    if (this != &other) {
-        base = other.base;
-        angle = other.angle;
-        length = other.length;
-    }
-    return *this;
-}
-
 bool Segment::operator==(const Segment& other) const {
     return base == other.base && angle == other.angle && length == other.length;
 }
@@ -58,6 +44,7 @@ double Segment::normalize_angle(double angle) {
     return angle;
 }
 S2d Segment::calculate_extremite() const {
+    STATS_ADD(TRIG_CALLS, 2);
     return {base.x + length * std::cos(angle), base.y + length * std::sin(angle)};
 }
 
@@ -141,6 +128,7 @@ bool onSegment(const S2d& p, const S2d& q, const S2d& r) {
 }
 
 bool Segment::doIntersect(const Segment& s1, const Segment& s2) {
+    STATS_ADD(SEGMENT_PAIR_TESTS, 1);
     S2d p1 = s1.base, q1 = s1.calculate_extremite();
     S2d p2 = s2.base, q2 = s2.calculate_extremite();
 
@@ -192,6 +180,7 @@ bool Segment::doIntersect(const Segment& s1, const Segment& s2) {
 
 bool Segment::areSegmentsInSuperposition(const Segment& seg1,
                                          const Segment& seg2) const {
+    STATS_ADD(SEGMENT_PAIR_TESTS, 1);
     // Check for collinearity first
     int orientation1 =
         orientation(seg1.getBase(), seg1.calculate_extremite(), seg2.getBase());
@@ -253,6 +242,7 @@ void Segment::rotate(double rotation_angle) {
 }
 
 bool Segment::intersectsCircle(const S2d& center, double radius) const {
+    STATS_ADD(TRIG_CALLS, 4);
     // Vector from the base of the segment to the circle's center
     S2d baseToCenter{center.x - base.x, center.y - base.y};
 
@@ -276,6 +266,7 @@ bool Segment::intersectsCircle(const S2d& center, double radius) const {
 }
 
 bool Segment::intersectsPoint(const S2d& center) const {
+    STATS_ADD(TRIG_CALLS, 4);
     // Vector from the base of the segment to the circle's center
     S2d baseToCenter{center.x - base.x, center.y - base.y};
 
@@ -305,14 +296,10 @@ bool Cercle::is_inside(const S2d& point) const {
     return std::hypot(point.x - centre.x, point.y - centre.y) < rayon + epsil_zero;
 }
 
-Cercle::~Cercle() {}
-
 // Square
 
 Square::Square(const S2d& centre_, double side_) : centre(centre_), side(side_) {}
 
-Square::~Square() {}
-
 bool Square::is_inside(const S2d& point) const {
     double half_side = side / 2;
     return (std::fabs(point.x - centre.x) <= half_side + epsil_zero &&
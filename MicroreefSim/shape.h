@@ -16,6 +16,7 @@
 
 #include <cmath>  // For math constants and functions
 #include <iostream>
+#include <type_traits>
 
 constexpr double epsil_zero(0.5);
 
@@ -39,10 +40,8 @@ protected:
     double length;  // Length of the segment
 
 public:
+    // copies are plain memory copies (no virtual destructor, see the asserts below)
     Segment(const S2d& base_, double angle_, double length_);
-    Segment(const Segment& other);
-    Segment& operator=(const Segment& other);
-    virtual ~Segment();
     bool operator==(const Segment& other) const;
     bool operator!=(const Segment& other) const;
 
@@ -92,7 +91,6 @@ protected:
 
 public:
     Cercle(const S2d& centre_, double rayon_);
-    virtual ~Cercle();
 
     bool is_inside(const S2d& point) const;
 };
@@ -104,9 +102,18 @@ protected:
 
 public:
     Square(const S2d& centre_, double side_);
-    virtual ~Square();
 
     bool is_inside(const S2d& point) const;
 };
 
+// the geometry is stored by value in large vectors and copied on every update, so
+// it must stay plain data: no vtable, copies done with memcpy
+static_assert(std::is_trivially_copyable_v<S2d> && std::is_standard_layout_v<S2d>);
+static_assert(std::is_trivially_copyable_v<Segment> &&
+              std::is_standard_layout_v<Segment>);
+static_assert(std::is_trivially_copyable_v<Cercle> &&
+              std::is_trivially_copyable_v<Square>);
+static_assert(sizeof(S2d) == 2 * sizeof(double));
+static_assert(sizeof(Segment) == 4 * sizeof(double));
+
 #endif  // SHAPE_H